@@ -203,6 +203,8 @@ void AppModel::onResetWallet()
     assert(m_wallet.use_count() == 1);
     assert(m_db);
 
+    m_transactionStore.reset();
+    m_utxoStore.reset();
     m_wallet.reset();
     m_keyKeeper.reset();
     m_bitcoinClient.reset();
@@ -354,7 +356,11 @@ void AppModel::start()
     InitLtcClient();
     InitQtumClient();
 
+    m_transactionStore.reset();
+    m_utxoStore.reset();
     m_wallet = std::make_shared<WalletModel>(m_db, m_keyKeeper, nodeAddrStr, m_walletReactor);
+    m_transactionStore = std::make_unique<TransactionStore>(*m_wallet);
+    m_utxoStore = std::make_unique<UtxoStore>(*m_wallet);
 
     if (m_settings.getRunLocalNode())
     {
@@ -394,6 +400,18 @@ WalletModel::Ptr AppModel::getWallet() const
     return m_wallet;
 }
 
+TransactionStore& AppModel::getTransactionStore() const
+{
+    assert(m_transactionStore);
+    return *m_transactionStore;
+}
+
+UtxoStore& AppModel::getUtxoStore() const
+{
+    assert(m_utxoStore);
+    return *m_utxoStore;
+}
+
 WalletSettings& AppModel::getSettings() const
 {
     return m_settings;
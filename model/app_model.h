@@ -14,6 +14,8 @@
 #pragma once
 
 #include "wallet_model.h"
+#include "transaction_store.h"
+#include "utxo_store.h"
 #include "swap_coin_client_model.h"
 #include "settings.h"
 #include "messages.h"
@@ -48,6 +50,8 @@ public:
     void resetWallet();
 
     WalletModel::Ptr getWallet() const;
+    TransactionStore& getTransactionStore() const;
+    UtxoStore& getUtxoStore() const;
     WalletSettings& getSettings() const;
     MessageManager& getMessages();
     NodeModel& getNode();
@@ -87,6 +91,9 @@ private:
     beam::bitcoin::IBridgeHolder::Ptr m_qtumBridgeHolder;
 
     WalletModel::Ptr m_wallet;
+    // the stores follow m_wallet, must be destroyed before it
+    std::unique_ptr<TransactionStore> m_transactionStore;
+    std::unique_ptr<UtxoStore> m_utxoStore;
     beam::wallet::IPrivateKeyKeeper::Ptr m_keyKeeper;
     NodeModel m_nodeModel;
     WalletSettings& m_settings;
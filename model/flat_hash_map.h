@@ -0,0 +1,172 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <functional>
+#include <utility>
+#include <vector>
+
+// Open addressing hash map with linear probing, all the entries live in one array.
+// Lookups never allocate, erase shifts the following entries back instead of leaving tombstones.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap
+{
+public:
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    // keeps the capacity, a rebuild of the same size does not allocate
+    void clear()
+    {
+        for (auto& slot : m_slots)
+        {
+            slot = Slot();
+        }
+        m_size = 0;
+    }
+
+    bool contains(const Key& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    const Value* find(const Key& key) const
+    {
+        if (m_size == 0)
+        {
+            return nullptr;
+        }
+        for (auto i = indexOf(key); m_slots[i].used; i = next(i))
+        {
+            if (m_slots[i].key == key)
+            {
+                return &m_slots[i].value;
+            }
+        }
+        return nullptr;
+    }
+
+    Value* find(const Key& key)
+    {
+        return const_cast<Value*>(static_cast<const FlatHashMap*>(this)->find(key));
+    }
+
+    // the value of the key, a default one is inserted if there is none
+    Value& operator[](const Key& key)
+    {
+        if ((m_size + 1) * 2 > m_slots.size())
+        {
+            rehash(m_slots.empty() ? kMinCapacity : m_slots.size() * 2);
+        }
+
+        auto i = indexOf(key);
+        for (; m_slots[i].used; i = next(i))
+        {
+            if (m_slots[i].key == key)
+            {
+                return m_slots[i].value;
+            }
+        }
+        m_slots[i].used = true;
+        m_slots[i].key = key;
+        ++m_size;
+        return m_slots[i].value;
+    }
+
+    bool erase(const Key& key)
+    {
+        if (m_size == 0)
+        {
+            return false;
+        }
+
+        auto i = indexOf(key);
+        for (; m_slots[i].used; i = next(i))
+        {
+            if (m_slots[i].key == key)
+            {
+                break;
+            }
+        }
+        if (!m_slots[i].used)
+        {
+            return false;
+        }
+
+        // move back every following entry which would not be found past the hole
+        for (auto j = next(i); m_slots[j].used; j = next(j))
+        {
+            const auto home = indexOf(m_slots[j].key);
+            const bool stays = i <= j ? (home > i && home <= j) : (home > i || home <= j);
+            if (!stays)
+            {
+                m_slots[i] = std::move(m_slots[j]);
+                i = j;
+            }
+        }
+        m_slots[i] = Slot();
+        --m_size;
+        return true;
+    }
+
+private:
+    static constexpr size_t kMinCapacity = 16;
+
+    struct Slot
+    {
+        bool used = false;
+        Key key = Key();
+        Value value = Value();
+    };
+
+    // the capacity is a power of two
+    size_t indexOf(const Key& key) const
+    {
+        return Hash()(key) & (m_slots.size() - 1);
+    }
+
+    size_t next(size_t i) const
+    {
+        return (i + 1) & (m_slots.size() - 1);
+    }
+
+    void rehash(size_t capacity)
+    {
+        std::vector<Slot> slots(capacity);
+        std::swap(slots, m_slots);
+        for (auto& slot : slots)
+        {
+            if (slot.used)
+            {
+                auto i = indexOf(slot.key);
+                while (m_slots[i].used)
+                {
+                    i = next(i);
+                }
+                m_slots[i] = std::move(slot);
+            }
+        }
+    }
+
+    std::vector<Slot> m_slots;
+    size_t m_size = 0;
+};
@@ -0,0 +1,190 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+// Functions posted from any thread and run by one consumer thread in the order they came in.
+// The producers never lock, the consumer is woken up once per drain instead of once per function.
+class FunctionQueue
+{
+public:
+    using Function = std::function<void()>;
+
+    struct Stats
+    {
+        // functions posted but not run yet
+        size_t depth = 0;
+        size_t maxDepth = 0;
+        uint64_t drains = 0;
+        uint64_t executed = 0;
+        // time from the wake-up request to the start of the drain
+        int64_t lastDrainLatencyUs = 0;
+        int64_t maxDrainLatencyUs = 0;
+    };
+
+    FunctionQueue()
+        : m_head(&m_stub)
+        , m_tail(&m_stub)
+    {
+    }
+
+    FunctionQueue(const FunctionQueue&) = delete;
+    FunctionQueue& operator=(const FunctionQueue&) = delete;
+
+    ~FunctionQueue()
+    {
+        while (auto node = pop())
+        {
+            delete node;
+        }
+    }
+
+    // any thread, returns true if the consumer has to be woken up to drain the queue
+    bool push(Function&& func)
+    {
+        auto depth = m_depth.fetch_add(1, std::memory_order_relaxed) + 1;
+        auto maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+        while (depth > maxDepth && !m_maxDepth.compare_exchange_weak(maxDepth, depth, std::memory_order_relaxed))
+        {
+        }
+
+        pushNode(new Node(std::move(func)));
+
+        if (m_wakeRequested.exchange(true, std::memory_order_acq_rel))
+        {
+            return false;
+        }
+        m_wakeTime.store(now(), std::memory_order_relaxed);
+        return true;
+    }
+
+    // consumer thread, runs everything posted before the call
+    void drain()
+    {
+        // a push after this point requests a new wake-up, so nothing is left behind
+        if (!m_wakeRequested.exchange(false, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        const auto latency = (now() - m_wakeTime.load(std::memory_order_relaxed)) / 1000;
+        m_lastDrainLatencyUs.store(latency, std::memory_order_relaxed);
+        if (latency > m_maxDrainLatencyUs.load(std::memory_order_relaxed))
+        {
+            m_maxDrainLatencyUs.store(latency, std::memory_order_relaxed);
+        }
+        m_drains.fetch_add(1, std::memory_order_relaxed);
+
+        while (auto node = pop())
+        {
+            auto func = std::move(node->func);
+            delete node;
+            m_depth.fetch_sub(1, std::memory_order_relaxed);
+            m_executed.fetch_add(1, std::memory_order_relaxed);
+            func();
+        }
+    }
+
+    Stats getStats() const
+    {
+        Stats stats;
+        stats.depth = m_depth.load(std::memory_order_relaxed);
+        stats.maxDepth = m_maxDepth.load(std::memory_order_relaxed);
+        stats.drains = m_drains.load(std::memory_order_relaxed);
+        stats.executed = m_executed.load(std::memory_order_relaxed);
+        stats.lastDrainLatencyUs = m_lastDrainLatencyUs.load(std::memory_order_relaxed);
+        stats.maxDrainLatencyUs = m_maxDrainLatencyUs.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+private:
+    struct Node
+    {
+        Node() = default;
+        explicit Node(Function&& f)
+            : func(std::move(f))
+        {
+        }
+
+        std::atomic<Node*> next{ nullptr };
+        Function func;
+    };
+
+    static int64_t now()
+    {
+        using namespace std::chrono;
+        return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count();
+    }
+
+    void pushNode(Node* node)
+    {
+        node->next.store(nullptr, std::memory_order_relaxed);
+        auto prev = m_head.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // intrusive queue with a stub node, returns nullptr when it is empty
+    // or when the last producer has not linked its node yet
+    Node* pop()
+    {
+        auto tail = m_tail;
+        auto next = tail->next.load(std::memory_order_acquire);
+        if (tail == &m_stub)
+        {
+            if (!next)
+            {
+                return nullptr;
+            }
+            m_tail = next;
+            tail = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (next)
+        {
+            m_tail = next;
+            return tail;
+        }
+        if (tail != m_head.load(std::memory_order_acquire))
+        {
+            return nullptr;
+        }
+        pushNode(&m_stub);
+        next = tail->next.load(std::memory_order_acquire);
+        if (next)
+        {
+            m_tail = next;
+            return tail;
+        }
+        return nullptr;
+    }
+
+    Node m_stub;
+    // producers push at the head, the consumer pops at the tail
+    std::atomic<Node*> m_head;
+    Node* m_tail;
+    std::atomic<bool> m_wakeRequested{ false };
+    std::atomic<int64_t> m_wakeTime{ 0 };
+
+    std::atomic<size_t> m_depth{ 0 };
+    std::atomic<size_t> m_maxDepth{ 0 };
+    std::atomic<uint64_t> m_drains{ 0 };
+    std::atomic<uint64_t> m_executed{ 0 };
+    std::atomic<int64_t> m_lastDrainLatencyUs{ 0 };
+    std::atomic<int64_t> m_maxDrainLatencyUs{ 0 };
+};
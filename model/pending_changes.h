@@ -0,0 +1,209 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "wallet/client/wallet_client.h"
+#include <boost/optional.hpp>
+#include <map>
+#include <utility>
+#include <vector>
+
+// Change notifications of one kind collapsed per item key, the receiver gets
+// the same state as if it had applied every notification one by one
+template <typename T, typename KeyOf>
+class PendingChanges
+{
+public:
+    using Key = std::decay_t<decltype(KeyOf()(std::declval<const T&>()))>;
+    using Batch = std::pair<beam::wallet::ChangeAction, std::vector<T>>;
+
+    bool empty() const
+    {
+        return !m_reset && m_changes.empty();
+    }
+
+    void add(beam::wallet::ChangeAction action, const std::vector<T>& items)
+    {
+        using beam::wallet::ChangeAction;
+        if (action == ChangeAction::Reset)
+        {
+            clear();
+            m_reset = true;
+            for (const auto& item : items)
+            {
+                addToSnapshot(ChangeAction::Added, item);
+            }
+            return;
+        }
+
+        for (const auto& item : items)
+        {
+            if (m_reset)
+            {
+                addToSnapshot(action, item);
+            }
+            else
+            {
+                addChange(action, item);
+            }
+        }
+    }
+
+    // batches in the order they have to be applied, the pending changes are cleared
+    std::vector<Batch> take()
+    {
+        using beam::wallet::ChangeAction;
+        std::vector<Batch> batches;
+        if (m_reset)
+        {
+            std::vector<T> items;
+            items.reserve(m_snapshot.size());
+            for (auto& item : m_snapshot)
+            {
+                if (item)
+                {
+                    items.push_back(std::move(*item));
+                }
+            }
+            batches.emplace_back(ChangeAction::Reset, std::move(items));
+        }
+        else
+        {
+            std::vector<T> removed, added, updated;
+            for (const auto& key : m_order)
+            {
+                auto it = m_changes.find(key);
+                if (it == m_changes.end())
+                {
+                    continue;
+                }
+                auto& change = it->second;
+                if (change.removed)
+                {
+                    removed.push_back(std::move(*change.removed));
+                }
+                if (change.upserted)
+                {
+                    (change.added ? added : updated).push_back(std::move(*change.upserted));
+                }
+                m_changes.erase(it);
+            }
+
+            // an item removed and then added again goes to both batches, removals go first
+            for (auto action : { ChangeAction::Removed, ChangeAction::Added, ChangeAction::Updated })
+            {
+                auto& items = action == ChangeAction::Removed ? removed : (action == ChangeAction::Added ? added : updated);
+                if (!items.empty())
+                {
+                    batches.emplace_back(action, std::move(items));
+                }
+            }
+        }
+        clear();
+        return batches;
+    }
+
+private:
+    struct Change
+    {
+        // the item as it goes to the Removed batch
+        boost::optional<T> removed;
+        // the latest state of the item for the Added or Updated batch
+        boost::optional<T> upserted;
+        bool added = false;
+    };
+
+    void clear()
+    {
+        m_reset = false;
+        m_changes.clear();
+        m_order.clear();
+        m_snapshot.clear();
+        m_snapshotIndex.clear();
+    }
+
+    void addChange(beam::wallet::ChangeAction action, const T& item)
+    {
+        using beam::wallet::ChangeAction;
+        const auto key = KeyOf()(item);
+        auto p = m_changes.emplace(key, Change());
+        if (p.second)
+        {
+            m_order.push_back(key);
+        }
+
+        auto& change = p.first->second;
+        switch (action)
+        {
+        case ChangeAction::Added:
+            // an update of an item the receiver already has stays an update
+            change.added = !change.upserted || change.added;
+            change.upserted = item;
+            break;
+
+        case ChangeAction::Updated:
+            change.upserted = item;
+            break;
+
+        case ChangeAction::Removed:
+            if (change.added && !change.removed)
+            {
+                // the receiver has never seen this item
+                m_changes.erase(p.first);
+                return;
+            }
+            change.upserted.reset();
+            change.added = false;
+            if (!change.removed)
+            {
+                change.removed = item;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    void addToSnapshot(beam::wallet::ChangeAction action, const T& item)
+    {
+        const auto key = KeyOf()(item);
+        auto it = m_snapshotIndex.find(key);
+        if (action == beam::wallet::ChangeAction::Removed)
+        {
+            if (it != m_snapshotIndex.end())
+            {
+                m_snapshot[it->second].reset();
+            }
+        }
+        else if (it != m_snapshotIndex.end())
+        {
+            m_snapshot[it->second] = item;
+        }
+        else
+        {
+            m_snapshotIndex.emplace(key, m_snapshot.size());
+            m_snapshot.emplace_back(item);
+        }
+    }
+
+    bool m_reset = false;
+    std::map<Key, Change> m_changes;
+    // keys in the order of their first change, the batches keep it
+    std::vector<Key> m_order;
+    // the rows after a pending reset, removed ones are left empty
+    std::vector<boost::optional<T>> m_snapshot;
+    std::map<Key, size_t> m_snapshotIndex;
+};
@@ -0,0 +1,103 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "transaction_store.h"
+
+using namespace beam::wallet;
+using namespace std;
+
+TransactionStore::TransactionStore(WalletModel& walletModel)
+{
+    connect(&walletModel,
+            SIGNAL(transactionsChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>&)),
+            SLOT(onTransactionsChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>&)));
+
+    // the only full load, later the wallet reports the changes
+    walletModel.getAsync()->getTransactions();
+}
+
+bool TransactionStore::isLoaded() const
+{
+    return m_loaded;
+}
+
+SharedItems<TxDescription> TransactionStore::getTransactions(Kind kind) const
+{
+    auto& snapshot = m_snapshots[kind];
+    if (!snapshot)
+    {
+        vector<TxDescription> items;
+        items.reserve(m_transactions.size());
+        for (const auto& p : m_transactions)
+        {
+            if (kind == Kind::All || p.second.swap == (kind == Kind::Swap))
+            {
+                items.push_back(p.second.tx);
+            }
+        }
+        snapshot = make_shared<const vector<TxDescription>>(move(items));
+    }
+    return snapshot;
+}
+
+void TransactionStore::onTransactionsChanged(ChangeAction action, const SharedItems<TxDescription>& items)
+{
+    if (action == ChangeAction::Reset)
+    {
+        m_transactions.clear();
+        m_loaded = true;
+    }
+
+    vector<TxDescription> simple;
+    vector<TxDescription> swap;
+    for (const auto& tx : *items)
+    {
+        auto it = m_transactions.find(tx.m_txId);
+        // removed transactions keep the kind they were stored with
+        const bool swapTx = it != m_transactions.end() ? it->second.swap : isSwap(tx);
+        if (action == ChangeAction::Removed)
+        {
+            if (it != m_transactions.end())
+            {
+                m_transactions.erase(it);
+            }
+        }
+        else if (it != m_transactions.end())
+        {
+            it->second.tx = tx;
+        }
+        else
+        {
+            m_transactions.emplace(tx.m_txId, Entry{ tx, swapTx });
+        }
+        (swapTx ? swap : simple).push_back(tx);
+    }
+    m_snapshots.clear();
+
+    emit transactionsChanged(action, items);
+    // a reset goes to both kinds even if one of them is empty now
+    if (action == ChangeAction::Reset || !simple.empty())
+    {
+        emit simpleTransactionsChanged(action, make_shared<const vector<TxDescription>>(move(simple)));
+    }
+    if (action == ChangeAction::Reset || !swap.empty())
+    {
+        emit swapTransactionsChanged(action, make_shared<const vector<TxDescription>>(move(swap)));
+    }
+}
+
+bool TransactionStore::isSwap(const TxDescription& tx)
+{
+    return tx.GetParameter<TxType>(TxParameterID::TransactionType) == TxType::AtomicSwap;
+}
@@ -0,0 +1,63 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+
+#include "wallet_model.h"
+#include <map>
+
+// The transactions of the wallet loaded once and kept up to date for all the views.
+// A view takes the current snapshot when it is created and then follows the changes
+// of its kind, so opening a screen never goes to the database.
+class TransactionStore : public QObject
+{
+    Q_OBJECT
+public:
+    enum class Kind
+    {
+        All,
+        Simple,
+        Swap
+    };
+
+    explicit TransactionStore(WalletModel& walletModel);
+
+    // false until the first snapshot comes from the database, the views get it as Reset
+    bool isLoaded() const;
+    SharedItems<beam::wallet::TxDescription> getTransactions(Kind kind = Kind::All) const;
+
+signals:
+    void transactionsChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>& items);
+    void simpleTransactionsChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>& items);
+    void swapTransactionsChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>& items);
+
+private slots:
+    void onTransactionsChanged(beam::wallet::ChangeAction action, const SharedItems<beam::wallet::TxDescription>& items);
+
+private:
+    struct Entry
+    {
+        beam::wallet::TxDescription tx;
+        bool swap;
+    };
+
+    static bool isSwap(const beam::wallet::TxDescription& tx);
+
+    bool m_loaded = false;
+    std::map<beam::wallet::TxID, Entry> m_transactions;
+    // snapshots handed out since the last change, built on demand
+    mutable std::map<Kind, SharedItems<beam::wallet::TxDescription>> m_snapshots;
+};
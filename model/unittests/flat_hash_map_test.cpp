@@ -0,0 +1,118 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "model/flat_hash_map.h"
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+namespace
+{
+    int g_failures = 0;
+
+#define CHECK(expr) \
+    if (!(expr)) { std::cerr << __FILE__ << ":" << __LINE__ << " check failed: " #expr << std::endl; ++g_failures; }
+
+    // few distinct hashes, so long probe runs wrap around the table and erase has to shift them back
+    struct CollidingHash
+    {
+        size_t operator()(int key) const
+        {
+            return static_cast<size_t>(key % 7) * 5;
+        }
+    };
+
+    template <typename Map, typename Reference>
+    bool sameContents(const Map& map, const Reference& reference, int keyRange)
+    {
+        if (map.size() != reference.size())
+        {
+            return false;
+        }
+        for (int key = 0; key < keyRange; ++key)
+        {
+            auto it = reference.find(key);
+            const auto* value = map.find(key);
+            if ((it == reference.end()) != (value == nullptr) || (value && *value != it->second))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // random inserts and erases give the same contents as std::unordered_map
+    void TestAgainstUnorderedMap()
+    {
+        const int kKeyRange = 500;
+        FlatHashMap<int, int, CollidingHash> map;
+        std::unordered_map<int, int> reference;
+        std::mt19937 random(42);
+        std::uniform_int_distribution<int> keys(0, kKeyRange - 1);
+
+        bool same = true;
+        for (int step = 0; step < 20000 && same; ++step)
+        {
+            const int key = keys(random);
+            if (random() % 3 == 0)
+            {
+                CHECK(map.erase(key) == (reference.erase(key) == 1));
+            }
+            else
+            {
+                map[key] = step;
+                reference[key] = step;
+            }
+            if (step % 100 == 0)
+            {
+                same = sameContents(map, reference, kKeyRange);
+            }
+        }
+        CHECK(same);
+        CHECK(sameContents(map, reference, kKeyRange));
+    }
+
+    void TestClearAndStrings()
+    {
+        FlatHashMap<std::string, int> map;
+        CHECK(map.empty());
+        CHECK(map.find("label") == nullptr);
+        CHECK(!map.erase("label"));
+
+        ++map["label"];
+        ++map["label"];
+        ++map["other"];
+        CHECK(map.size() == 2);
+        CHECK(map.contains("label"));
+        CHECK(*map.find("label") == 2);
+
+        CHECK(map.erase("label"));
+        CHECK(!map.contains("label"));
+        CHECK(map.contains("other"));
+
+        map.clear();
+        CHECK(map.empty());
+        CHECK(!map.contains("other"));
+        map["again"] = 1;
+        CHECK(map.size() == 1);
+    }
+}
+
+int main()
+{
+    TestClearAndStrings();
+    TestAgainstUnorderedMap();
+    return g_failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,123 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "model/function_queue.h"
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    int g_failures = 0;
+
+#define CHECK(expr) \
+    if (!(expr)) { std::cerr << __FILE__ << ":" << __LINE__ << " check failed: " #expr << std::endl; ++g_failures; }
+
+    const int kProducers = 4;
+    const int kFunctionsPerProducer = 100000;
+
+    // every producer posts numbered functions while one consumer drains on each wake-up,
+    // the functions of a producer have to run in order and none may be left behind
+    void TestMultiProducerDrain()
+    {
+        FunctionQueue queue;
+        std::atomic<int> wakeUps{ 0 };
+        std::atomic<bool> producing{ true };
+        // written by the consumer only, inside the functions
+        std::vector<int> lastSeen(kProducers, -1);
+        int executed = 0;
+        int outOfOrder = 0;
+
+        std::thread consumer([&]()
+        {
+            int handled = 0;
+            while (producing || handled < wakeUps)
+            {
+                if (handled < wakeUps)
+                {
+                    ++handled;
+                    queue.drain();
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        std::vector<std::thread> producers;
+        for (int producer = 0; producer < kProducers; ++producer)
+        {
+            producers.emplace_back([&, producer]()
+            {
+                for (int i = 0; i < kFunctionsPerProducer; ++i)
+                {
+                    const bool wake = queue.push([&, producer, i]()
+                    {
+                        if (lastSeen[producer] + 1 != i)
+                        {
+                            ++outOfOrder;
+                        }
+                        lastSeen[producer] = i;
+                        ++executed;
+                    });
+                    if (wake)
+                    {
+                        ++wakeUps;
+                    }
+                }
+            });
+        }
+
+        for (auto& producer : producers)
+        {
+            producer.join();
+        }
+        producing = false;
+        consumer.join();
+
+        const auto stats = queue.getStats();
+        CHECK(executed == kProducers * kFunctionsPerProducer);
+        CHECK(outOfOrder == 0);
+        CHECK(stats.executed == static_cast<uint64_t>(kProducers * kFunctionsPerProducer));
+        CHECK(stats.depth == 0);
+        CHECK(stats.maxDepth >= 1);
+        CHECK(stats.drains >= 1);
+        CHECK(stats.drains <= static_cast<uint64_t>(wakeUps));
+    }
+
+    // a drain without a wake-up request runs nothing, the functions wait for the next one
+    void TestDrainWithoutWakeUp()
+    {
+        FunctionQueue queue;
+        int executed = 0;
+        CHECK(queue.push([&]() { ++executed; }));
+        CHECK(!queue.push([&]() { ++executed; }));
+        queue.drain();
+        CHECK(executed == 2);
+        queue.drain();
+        CHECK(executed == 2);
+        CHECK(queue.push([&]() { ++executed; }));
+        queue.drain();
+        CHECK(executed == 3);
+    }
+}
+
+int main()
+{
+    TestDrainWithoutWakeUp();
+    TestMultiProducerDrain();
+    return g_failures == 0 ? 0 : 1;
+}
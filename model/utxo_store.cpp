@@ -0,0 +1,78 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "utxo_store.h"
+
+using namespace beam::wallet;
+using namespace std;
+
+UtxoStore::UtxoStore(WalletModel& walletModel)
+    : m_walletModel(walletModel)
+{
+    connect(&walletModel,
+            SIGNAL(allUtxoChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::Coin>&)),
+            SLOT(onAllUtxoChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::Coin>&)));
+    connect(&walletModel, SIGNAL(stateIDChanged()), SLOT(onStateChanged()));
+
+    // the only full load asked by the store, later the wallet reports the changes
+    walletModel.getAsync()->getUtxosStatus();
+}
+
+bool UtxoStore::isLoaded() const
+{
+    return m_loaded;
+}
+
+UtxoItemList& UtxoStore::getUtxos()
+{
+    return m_utxos;
+}
+
+void UtxoStore::onAllUtxoChanged(ChangeAction action, const SharedItems<Coin>& utxos)
+{
+    // the list takes only the fields it shows from the coins
+    switch (action)
+    {
+    case ChangeAction::Reset:
+        m_utxos.reset(*utxos);
+        m_loaded = true;
+        break;
+
+    case ChangeAction::Removed:
+        m_utxos.remove(*utxos);
+        break;
+
+    case ChangeAction::Added:
+        m_utxos.insert(*utxos);
+        break;
+
+    case ChangeAction::Updated:
+        m_utxos.update(*utxos);
+        break;
+
+    default:
+        assert(false && "Unexpected action");
+        break;
+    }
+
+    emit utxosChanged(action, utxos);
+}
+
+void UtxoStore::onStateChanged()
+{
+    if (m_utxos.setCurrentHeight(m_walletModel.getCurrentHeight()) > 0)
+    {
+        emit utxosMatured();
+    }
+}
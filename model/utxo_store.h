@@ -0,0 +1,48 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QObject>
+
+#include "wallet_model.h"
+#include "viewmodel/utxo/utxo_item_list.h"
+
+// The coins of the wallet loaded once and kept up to date in a single column store,
+// every screen which needs them shows or reads this list instead of asking the wallet for a full reload.
+class UtxoStore : public QObject
+{
+    Q_OBJECT
+public:
+    explicit UtxoStore(WalletModel& walletModel);
+
+    // false until the first snapshot comes from the database, the views get it as Reset
+    bool isLoaded() const;
+    UtxoItemList& getUtxos();
+
+signals:
+    // the list has already taken the batch when it is emitted
+    void utxosChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::Coin>& utxos);
+    // maturing coins have reached the new tip, the wallet reports them available later
+    void utxosMatured();
+
+private slots:
+    void onAllUtxoChanged(beam::wallet::ChangeAction action, const SharedItems<beam::wallet::Coin>& utxos);
+    void onStateChanged();
+
+private:
+    WalletModel& m_walletModel;
+    bool m_loaded = false;
+    UtxoItemList m_utxos;
+};
@@ -18,12 +18,19 @@
 #include "utility/bridge.h"
 #include "utility/io/asyncevent.h"
 #include "utility/helpers.h"
+#include <algorithm>
 
 using namespace beam;
 using namespace beam::wallet;
 using namespace beam::io;
 using namespace std;
 
+namespace
+{
+    const int kFlushInterval = 16; // ms
+    const qint64 kPostedFunctionStatsInterval = 5 * 60 * 1000; // ms
+}
+
 WalletModel::WalletModel(IWalletDB::Ptr walletDB, IPrivateKeyKeeper::Ptr keyKeeper, const std::string& nodeAddr, beam::io::Reactor::Ptr reactor)
     : WalletClient(walletDB, nodeAddr, reactor, keyKeeper)
 {
@@ -40,12 +47,18 @@ WalletModel::WalletModel(IWalletDB::Ptr walletDB, IPrivateKeyKeeper::Ptr keyKeep
     qRegisterMetaType<beam::wallet::ErrorType>("beam::wallet::ErrorType");
     qRegisterMetaType<beam::wallet::TxID>("beam::wallet::TxID");
     qRegisterMetaType<beam::wallet::TxParameters>("beam::wallet::TxParameters");
-    qRegisterMetaType<std::function<void()>>("std::function<void()>");
+    qRegisterMetaType<SharedItems<beam::wallet::TxDescription>>("SharedItems<beam::wallet::TxDescription>");
+    qRegisterMetaType<SharedItems<beam::wallet::Coin>>("SharedItems<beam::wallet::Coin>");
+    qRegisterMetaType<SharedItems<beam::wallet::WalletAddress>>("SharedItems<beam::wallet::WalletAddress>");
+    qRegisterMetaType<SharedItems<beam::wallet::SwapOffer>>("SharedItems<beam::wallet::SwapOffer>");
 
     connect(this, SIGNAL(walletStatus(const beam::wallet::WalletStatus&)), this, SLOT(setStatus(const beam::wallet::WalletStatus&)));
-    connect(this, SIGNAL(addressesChanged(bool, const std::vector<beam::wallet::WalletAddress>&)),
-            this, SLOT(setAddresses(bool, const std::vector<beam::wallet::WalletAddress>&)));
-    connect(this, SIGNAL(functionPosted(const std::function<void()>&)), this, SLOT(doFunction(const std::function<void()>&)));
+    connect(this, SIGNAL(addressesChanged(bool, const SharedItems<beam::wallet::WalletAddress>&)),
+            this, SLOT(setAddresses(bool, const SharedItems<beam::wallet::WalletAddress>&)));
+
+    m_flushTimer.setSingleShot(true);
+    m_flushTimer.setInterval(kFlushInterval);
+    connect(&m_flushTimer, SIGNAL(timeout()), this, SLOT(flushChanges()));
 
     getAsync()->getAddresses(true);
 }
@@ -98,7 +111,7 @@ QString WalletModel::GetErrorString(beam::wallet::ErrorType type)
 
 bool WalletModel::isOwnAddress(const WalletID& walletID) const
 {
-    return m_myWalletIds.find(walletID) != m_myWalletIds.end();
+    return m_myWalletIds.contains(walletID);
 }
 
 bool WalletModel::isAddressWithCommentExist(const std::string& comment) const
@@ -107,7 +120,7 @@ bool WalletModel::isAddressWithCommentExist(const std::string& comment) const
     {
         return false;
     }
-    return m_myAddrLabels.find(comment) != m_myAddrLabels.end();
+    return m_myAddrLabels.contains(comment);
 }
 
 void WalletModel::onStatus(const beam::wallet::WalletStatus& status)
@@ -117,7 +130,10 @@ void WalletModel::onStatus(const beam::wallet::WalletStatus& status)
 
 void WalletModel::onTxStatus(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items)
 {
-    emit transactionsChanged(action, items);
+    QMutexLocker lock(&m_changesMutex);
+    m_pendingTransactions.add(action, items);
+    addPendingKind(PendingKind::Transactions);
+    scheduleFlush();
 }
 
 void WalletModel::onSyncProgressUpdated(int done, int total)
@@ -125,45 +141,157 @@ void WalletModel::onSyncProgressUpdated(int done, int total)
     emit syncProgressUpdated(done, total);
 }
 
+void WalletModel::calcChange(beam::Amount amount)
+{
+    {
+        QMutexLocker lock(&m_changeRequestsMutex);
+        m_changeRequests.push_back(amount);
+    }
+    getAsync()->calcChange(amount);
+}
+
 void WalletModel::onChangeCalculated(beam::Amount change)
 {
-    emit changeCalculated(change);
+    beam::Amount amount = 0;
+    {
+        QMutexLocker lock(&m_changeRequestsMutex);
+        if (!m_changeRequests.empty())
+        {
+            amount = m_changeRequests.front();
+            m_changeRequests.pop_front();
+        }
+    }
+    emit changeCalculated(amount, change);
 }
 
 void WalletModel::onAllUtxoChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& utxos)
 {
-    emit allUtxoChanged(action, utxos);
+    QMutexLocker lock(&m_changesMutex);
+    m_pendingUtxos.add(action, utxos);
+    addPendingKind(PendingKind::Utxos);
+    scheduleFlush();
 }
 
 void WalletModel::onAddressesChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::WalletAddress>& items)
 {
-    emit addressesChanged(action, items);
-    for (const auto& item : items)
-    {
-        if (item.isOwn())
-        {
-            if (action == ChangeAction::Removed)
-            {
-                m_myWalletIds.erase(item.m_walletID);
-                m_myAddrLabels.erase(item.m_label);
-            }
-            else
-            {
-                m_myWalletIds.emplace(item.m_walletID);
-                m_myAddrLabels.emplace(item.m_label);
-            }
-        }
-    }
+    QMutexLocker lock(&m_changesMutex);
+    m_pendingAddresses.add(action, items);
+    addPendingKind(PendingKind::Addresses);
+    scheduleFlush();
 }
 
 void WalletModel::onAddresses(bool own, const std::vector<beam::wallet::WalletAddress>& addrs)
 {
-    emit addressesChanged(own, addrs);
+    // the list goes through the pending changes, so the address changes reported
+    // before it are delivered before it and the ones reported after it, after it
+    QMutexLocker lock(&m_changesMutex);
+    PendingAddressList list;
+    list.changesBefore = m_pendingAddresses.take();
+    list.own = own;
+    list.addresses = addrs;
+    m_pendingAddressLists.push_back(std::move(list));
+
+    m_pendingKinds.erase(std::remove(m_pendingKinds.begin(), m_pendingKinds.end(), PendingKind::Addresses), m_pendingKinds.end());
+    m_pendingKinds.push_back(PendingKind::AddressList);
+    scheduleFlush();
 }
 
 void WalletModel::onSwapOffersChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::SwapOffer>& offers)
 {
-    emit swapOffersChanged(action, offers);
+    QMutexLocker lock(&m_changesMutex);
+    m_pendingSwapOffers.add(action, offers);
+    addPendingKind(PendingKind::SwapOffers);
+    scheduleFlush();
+}
+
+// must be called with m_changesMutex locked
+void WalletModel::addPendingKind(PendingKind kind)
+{
+    if (std::find(m_pendingKinds.begin(), m_pendingKinds.end(), kind) == m_pendingKinds.end())
+    {
+        m_pendingKinds.push_back(kind);
+    }
+}
+
+// must be called with m_changesMutex locked
+void WalletModel::scheduleFlush()
+{
+    if (!m_flushScheduled)
+    {
+        m_flushScheduled = true;
+        // the timer lives in the UI thread, the changes come from the wallet one
+        QMetaObject::invokeMethod(this, [this]() { m_flushTimer.start(); }, Qt::QueuedConnection);
+    }
+}
+
+void WalletModel::flushChanges()
+{
+    std::vector<PendingKind> kinds;
+    decltype(m_pendingTransactions.take()) transactions;
+    decltype(m_pendingUtxos.take()) utxos;
+    decltype(m_pendingAddresses.take()) addresses;
+    decltype(m_pendingSwapOffers.take()) swapOffers;
+    std::deque<PendingAddressList> addressLists;
+    {
+        QMutexLocker lock(&m_changesMutex);
+        m_flushScheduled = false;
+        kinds.swap(m_pendingKinds);
+        transactions = m_pendingTransactions.take();
+        utxos = m_pendingUtxos.take();
+        addresses = m_pendingAddresses.take();
+        swapOffers = m_pendingSwapOffers.take();
+        addressLists.swap(m_pendingAddressLists);
+    }
+
+    // batches are moved into the shared snapshots, no receiver copies them
+    auto emitAddresses = [this](decltype(addresses)& batches)
+    {
+        for (auto& batch : batches)
+        {
+            applyOwnAddresses(batch.first, batch.second);
+            emit addressesChanged(batch.first, std::make_shared<const std::vector<WalletAddress>>(std::move(batch.second)));
+        }
+    };
+
+    for (auto kind : kinds)
+    {
+        switch (kind)
+        {
+        case PendingKind::Transactions:
+            for (auto& batch : transactions)
+            {
+                emit transactionsChanged(batch.first, std::make_shared<const std::vector<TxDescription>>(std::move(batch.second)));
+            }
+            break;
+
+        case PendingKind::Utxos:
+            for (auto& batch : utxos)
+            {
+                emit allUtxoChanged(batch.first, std::make_shared<const std::vector<Coin>>(std::move(batch.second)));
+            }
+            break;
+
+        case PendingKind::Addresses:
+            emitAddresses(addresses);
+            break;
+
+        case PendingKind::SwapOffers:
+            for (auto& batch : swapOffers)
+            {
+                emit swapOffersChanged(batch.first, std::make_shared<const std::vector<SwapOffer>>(std::move(batch.second)));
+            }
+            break;
+
+        case PendingKind::AddressList:
+        {
+            auto& list = addressLists.front();
+            emitAddresses(list.changesBefore);
+            emit addressesChanged(list.own, std::make_shared<const std::vector<WalletAddress>>(std::move(list.addresses)));
+            addressLists.pop_front();
+            break;
+        }
+        }
+    }
 }
 
 void WalletModel::onCoinsByTx(const std::vector<beam::wallet::Coin>& coins)
@@ -278,7 +406,10 @@ void WalletModel::onPaymentProofExported(const beam::wallet::TxID& txID, const b
 
 void WalletModel::onPostFunctionToClientContext(MessageFunction&& func)
 {
-    emit functionPosted(func);
+    if (m_postedFunctions.push(std::move(func)))
+    {
+        QMetaObject::invokeMethod(this, "drainPostedFunctions", Qt::QueuedConnection);
+    }
 }
 
 beam::Amount WalletModel::getAvailable() const
@@ -366,22 +497,91 @@ void WalletModel::setStatus(const beam::wallet::WalletStatus& status)
     }
 }
 
-void WalletModel::setAddresses(bool own, const std::vector<beam::wallet::WalletAddress>& addrs)
+void WalletModel::setAddresses(bool own, const SharedItems<beam::wallet::WalletAddress>& addrs)
 {
     if (own)
+    {
+        applyOwnAddresses(ChangeAction::Reset, *addrs);
+    }
+}
+
+void WalletModel::applyOwnAddresses(beam::wallet::ChangeAction action, const std::vector<beam::wallet::WalletAddress>& items)
+{
+    if (action == ChangeAction::Reset)
     {
         m_myWalletIds.clear();
         m_myAddrLabels.clear();
+    }
 
-        for (const auto& addr : addrs)
+    for (const auto& item : items)
+    {
+        if (action == ChangeAction::Removed)
+        {
+            removeOwnAddress(item.m_walletID);
+        }
+        else if (item.isOwn())
         {
-            m_myWalletIds.emplace(addr.m_walletID);
-            m_myAddrLabels.emplace(addr.m_label);
+            addOwnAddress(item);
         }
     }
 }
 
-void WalletModel::doFunction(const std::function<void()>& func)
+void WalletModel::addOwnAddress(const beam::wallet::WalletAddress& address)
+{
+    if (auto label = m_myWalletIds.find(address.m_walletID))
+    {
+        if (*label == address.m_label)
+        {
+            return;
+        }
+        // the address has been renamed
+        releaseLabel(*label);
+        *label = address.m_label;
+    }
+    else
+    {
+        m_myWalletIds[address.m_walletID] = address.m_label;
+    }
+    ++m_myAddrLabels[address.m_label];
+}
+
+void WalletModel::removeOwnAddress(const beam::wallet::WalletID& walletID)
+{
+    if (auto label = m_myWalletIds.find(walletID))
+    {
+        releaseLabel(*label);
+        m_myWalletIds.erase(walletID);
+    }
+}
+
+void WalletModel::releaseLabel(const std::string& label)
+{
+    auto count = m_myAddrLabels.find(label);
+    if (count && --*count == 0)
+    {
+        m_myAddrLabels.erase(label);
+    }
+}
+
+void WalletModel::drainPostedFunctions()
+{
+    m_postedFunctions.drain();
+
+    if (!m_postedFunctionStatsTimer.isValid())
+    {
+        m_postedFunctionStatsTimer.start();
+    }
+    else if (m_postedFunctionStatsTimer.hasExpired(kPostedFunctionStatsInterval))
+    {
+        m_postedFunctionStatsTimer.restart();
+        logPostedFunctionStats();
+    }
+}
+
+void WalletModel::logPostedFunctionStats() const
 {
-    func();
+    const auto stats = m_postedFunctions.getStats();
+    LOG_INFO() << "Posted functions: executed " << stats.executed << " in " << stats.drains << " drains"
+               << ", depth " << stats.depth << " (max " << stats.maxDepth << ")"
+               << ", drain latency " << stats.lastDrainLatencyUs << " us (max " << stats.maxDrainLatencyUs << " us)";
 }
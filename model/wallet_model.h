@@ -15,9 +15,22 @@
 #pragma once
 
 #include <QObject>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QTimer>
 
 #include "wallet/client/wallet_client.h"
-#include <set>
+#include "pending_changes.h"
+#include "function_queue.h"
+#include "flat_hash_map.h"
+#include <cstring>
+#include <deque>
+#include <memory>
+
+// immutable batch of items, shared by all the receivers of a signal without copying,
+// queued connections copy the pointer only
+template <typename T>
+using SharedItems = std::shared_ptr<const std::vector<T>>;
 
 class WalletModel
     : public QObject
@@ -44,15 +57,19 @@ public:
     beam::Height getCurrentHeight() const;
     beam::Block::SystemState::ID getCurrentStateID() const;
 
+    // asks the wallet for the change of a transaction of the amount,
+    // changeCalculated reports the amount back with the change
+    void calcChange(beam::Amount amount);
+
 signals:
     void walletStatus(const beam::wallet::WalletStatus& status);
-    void transactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>& items);
+    void transactionsChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>& items);
     void syncProgressUpdated(int done, int total);
-    void changeCalculated(beam::Amount change);
-    void allUtxoChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::Coin>& utxos);
-    void addressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>& addresses);
-    void addressesChanged(bool own, const std::vector<beam::wallet::WalletAddress>& addresses);
-    void swapOffersChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::SwapOffer>& offers);
+    void changeCalculated(beam::Amount amount, beam::Amount change);
+    void allUtxoChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::Coin>& utxos);
+    void addressesChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::WalletAddress>& addresses);
+    void addressesChanged(bool own, const SharedItems<beam::wallet::WalletAddress>& addresses);
+    void swapOffersChanged(beam::wallet::ChangeAction action, const SharedItems<beam::wallet::SwapOffer>& offers);
     void generatedNewAddress(const beam::wallet::WalletAddress& walletAddr);
     void swapParamsLoaded(const beam::ByteBuffer& params);
     void newAddressFailed();
@@ -71,7 +88,6 @@ signals:
     void sendingChanged();
     void maturingChanged();
     void stateIDChanged();
-    void functionPosted(const std::function<void()>&);
 #if defined(BEAM_HW_WALLET)
     void showTrezorMessage();
     void hideTrezorMessage();
@@ -114,11 +130,89 @@ private:
 
 private slots:
     void setStatus(const beam::wallet::WalletStatus& status);
-    void setAddresses(bool own, const std::vector<beam::wallet::WalletAddress>& addrs);
-    void doFunction(const std::function<void()>& func);
+    void setAddresses(bool own, const SharedItems<beam::wallet::WalletAddress>& addrs);
+    void drainPostedFunctions();
+    void flushChanges();
 
 private:
-    std::set<beam::wallet::WalletID> m_myWalletIds;
-    std::set<std::string> m_myAddrLabels;
+    struct TxKey
+    {
+        const beam::wallet::TxID& operator()(const beam::wallet::TxDescription& tx) const { return tx.m_txId; }
+    };
+    struct CoinKey
+    {
+        const beam::wallet::Coin::ID& operator()(const beam::wallet::Coin& coin) const { return coin.m_ID; }
+    };
+    struct AddressKey
+    {
+        const beam::wallet::WalletID& operator()(const beam::wallet::WalletAddress& address) const { return address.m_walletID; }
+    };
+    struct SwapOfferKey
+    {
+        const beam::wallet::TxID& operator()(const beam::wallet::SwapOffer& offer) const { return offer.m_txId; }
+    };
+
+    // public keys are uniformly distributed, their first bytes are a good hash already
+    struct WalletIDHash
+    {
+        size_t operator()(const beam::wallet::WalletID& id) const
+        {
+            size_t hash = 0;
+            std::memcpy(&hash, id.m_Pk.m_pData, sizeof(hash));
+            return hash;
+        }
+    };
+
+    enum class PendingKind
+    {
+        Transactions,
+        Utxos,
+        Addresses,
+        SwapOffers,
+        AddressList
+    };
+
+    // a full list of own or peer addresses with the address changes reported before it
+    struct PendingAddressList
+    {
+        std::vector<PendingChanges<beam::wallet::WalletAddress, AddressKey>::Batch> changesBefore;
+        bool own = false;
+        std::vector<beam::wallet::WalletAddress> addresses;
+    };
+
+    void addPendingKind(PendingKind kind);
+    void scheduleFlush();
+    void logPostedFunctionStats() const;
+    void applyOwnAddresses(beam::wallet::ChangeAction action, const std::vector<beam::wallet::WalletAddress>& items);
+    void addOwnAddress(const beam::wallet::WalletAddress& address);
+    void removeOwnAddress(const beam::wallet::WalletID& walletID);
+    void releaseLabel(const std::string& label);
+
+    // own addresses with their labels and the number of own addresses per label,
+    // both are changed and read on the GUI thread only
+    FlatHashMap<beam::wallet::WalletID, std::string, WalletIDHash> m_myWalletIds;
+    FlatHashMap<std::string, int> m_myAddrLabels;
     beam::wallet::WalletStatus m_status;
+
+    // changes reported by the wallet thread are collected here and delivered
+    // to the views in one batch per kind and action a frame later,
+    // the kinds go out in the order their first change arrived
+    QMutex m_changesMutex;
+    bool m_flushScheduled = false;
+    QTimer m_flushTimer;
+    std::vector<PendingKind> m_pendingKinds;
+    std::deque<PendingAddressList> m_pendingAddressLists;
+    PendingChanges<beam::wallet::TxDescription, TxKey> m_pendingTransactions;
+    PendingChanges<beam::wallet::Coin, CoinKey> m_pendingUtxos;
+    PendingChanges<beam::wallet::WalletAddress, AddressKey> m_pendingAddresses;
+    PendingChanges<beam::wallet::SwapOffer, SwapOfferKey> m_pendingSwapOffers;
+
+    // amounts of the calcChange requests not answered yet, the wallet answers them in order
+    QMutex m_changeRequestsMutex;
+    std::deque<beam::Amount> m_changeRequests;
+
+    // functions posted from the wallet thread, run on the GUI thread in batches
+    FunctionQueue m_postedFunctions;
+    // the queue counters go to the log every few minutes, from a drain
+    QElapsedTimer m_postedFunctionStatsTimer;
 };
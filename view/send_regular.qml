@@ -37,6 +37,21 @@ ColumnLayout {
                 .createObject(sendRegularView)
                 .open();
         }
+
+        onSendMoneyFailed: {
+            sendFailedDialog.open();
+        }
+    }
+
+    ConfirmationDialog {
+        id:                  sendFailedDialog
+        parent:              Overlay.overlay
+        //% "Not enough funds to send this amount with the change, please check the amount and try again."
+        text:                qsTrId("send-not-enough-after-change-message")
+        //% "Ok"
+        okButtonText:        qsTrId("general-ok")
+        okButtonIconSource:  "qrc:/assets/icon-done.svg"
+        cancelButtonVisible: false
     }
 
     function isTAInputValid() {
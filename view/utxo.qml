@@ -128,6 +128,7 @@ ColumnLayout {
             source: viewModel.allUtxos
             filterSyntax: SortFilterProxyModel.Wildcard
             filterCaseSensitivity: Qt.CaseInsensitive
+            asynchronous: true
         }
         sortIndicatorVisible: true
         sortIndicatorColumn: 1
@@ -171,7 +172,9 @@ ColumnLayout {
                 width: parent.width
                 height: tableView.rowHeight
                 readonly property var lineSeparator: "\n"
-                property var texts: utxoStatusText(styleData.value).split(lineSeparator)
+                // a coin matured at the tip is shown available before the wallet reports it
+                property var status: (model && model.maturedAtTip) ? UtxoStatus.Available : styleData.value
+                property var texts: utxoStatusText(status).split(lineSeparator)
                 property color secondLineColor: Style.content_secondary
 
                 ColumnLayout {
@@ -183,7 +186,7 @@ ColumnLayout {
                         Layout.fillWidth: true
                         Layout.fillHeight: true
                         Layout.topMargin: secondLineEnabled() ? 0 : 20
-                        color: getTextColor(styleData.value)
+                        color: getTextColor(delegate_id.status)
                         elide: Text.ElideRight
                         text: delegate_id.texts[0]
                         textFormat: Text.StyledText
@@ -283,6 +283,17 @@ Item {
                 }
             ]
 
+            // the proxies see only the loaded rows, so a search, a tab filter or another order
+            // needs the whole history, the newest ones first are loaded page by page
+            Binding {
+                target:   viewModel
+                property: "transactionsPaged"
+                value:    searchBox.text.length == 0
+                          && transactionsLayout.state == "all"
+                          && transactionsTable.sortIndicatorColumn == 0
+                          && transactionsTable.sortIndicatorOrder == Qt.DescendingOrder
+            }
+
             CustomTableView {
                 id: transactionsTable
 
@@ -316,6 +327,7 @@ Item {
                         filterString: searchBox.text
                         filterSyntax: SortFilterProxyModel.Wildcard
                         filterCaseSensitivity: Qt.CaseInsensitive
+                        asynchronous: true
                     }
 
                     sortOrder: transactionsTable.sortIndicatorOrder
@@ -324,6 +336,7 @@ Item {
 
                     filterSyntax: SortFilterProxyModel.Wildcard
                     filterCaseSensitivity: Qt.CaseInsensitive
+                    asynchronous: true
                 }
 
                 rowDelegate: ExpandableRowDelegate {
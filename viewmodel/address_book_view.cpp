@@ -117,17 +117,21 @@ AddressBookViewModel::AddressBookViewModel()
     : m_model{*AppModel::getInstance().getWallet()}
 {
     connect(&m_model,
-            SIGNAL(addressesChanged(bool, const std::vector<beam::wallet::WalletAddress>&)),
-            SLOT(onAddresses(bool, const std::vector<beam::wallet::WalletAddress>&)));
+            SIGNAL(addressesChanged(bool, const SharedItems<beam::wallet::WalletAddress>&)),
+            SLOT(onAddresses(bool, const SharedItems<beam::wallet::WalletAddress>&)));
+    auto& transactionStore = AppModel::getInstance().getTransactionStore();
+    connect(&transactionStore,
+            SIGNAL(transactionsChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>&)),
+            SLOT(onTransactions(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>&)));
     connect(&m_model,
-            SIGNAL(transactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)),
-            SLOT(onTransactions(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)));
-    connect(&m_model,
-            SIGNAL(addressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>&)),
-            SLOT(onAddressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>&)));
+            SIGNAL(addressesChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::WalletAddress>&)),
+            SLOT(onAddressesChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::WalletAddress>&)));
 
     getAddressesFromModel();
-    m_model.getAsync()->getTransactions();
+    if (transactionStore.isLoaded())
+    {
+        onTransactions(ChangeAction::Reset, transactionStore.getTransactions());
+    }
     startTimer(3 * 1000);
 }
 
@@ -274,14 +278,14 @@ bool AddressBookViewModel::isAddressWithCommentExist(const QString& comment) con
     return m_model.isAddressWithCommentExist(comment.toStdString());
 }
 
-void AddressBookViewModel::onAddresses(bool own, const std::vector<beam::wallet::WalletAddress>& addresses)
+void AddressBookViewModel::onAddresses(bool own, const SharedItems<beam::wallet::WalletAddress>& addresses)
 {
     if (own)
     {
         m_activeAddresses.clear();
         m_expiredAddresses.clear();
 
-        for (const auto& addr : addresses)
+        for (const auto& addr : *addresses)
         {
             if (addr.isExpired())
             {
@@ -300,7 +304,7 @@ void AddressBookViewModel::onAddresses(bool own, const std::vector<beam::wallet:
     {
         m_contacts.clear();
 
-        for (const auto& addr : addresses)
+        for (const auto& addr : *addresses)
         {
             m_contacts.push_back(new ContactItem(addr));
         }
@@ -309,13 +313,13 @@ void AddressBookViewModel::onAddresses(bool own, const std::vector<beam::wallet:
     }
 }
 
-void AddressBookViewModel::onAddressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>& addresses)
+void AddressBookViewModel::onAddressesChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::WalletAddress>& addresses)
 {
     // TODO: refactor this
     getAddressesFromModel();
 }
 
-void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& transactions)
+void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, const SharedItems<beam::wallet::TxDescription>& transactions)
 {
     switch (action)
     {
@@ -327,7 +331,7 @@ void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, con
 
         case ChangeAction::Added:
             {
-                for (const auto& tx : transactions)
+                for (const auto& tx : *transactions)
                 {
                     if (!tx.canDelete())    // only active transactions
                     {
@@ -339,7 +343,7 @@ void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, con
         
         case ChangeAction::Updated:
             {
-                for (const auto& tx : transactions)
+                for (const auto& tx : *transactions)
                 {
                     auto it = find(m_busyAddresses.cbegin(), m_busyAddresses.cend(), tx.m_myId);
                     if (it != m_busyAddresses.cend() && tx.canDelete())
@@ -352,7 +356,7 @@ void AddressBookViewModel::onTransactions(beam::wallet::ChangeAction action, con
 
         case ChangeAction::Removed:
             {
-                for (const auto& tx : transactions)
+                for (const auto& tx : *transactions)
                 {
                     auto it = find(m_busyAddresses.cbegin(), m_busyAddresses.cend(), tx.m_myId);
                     if (it != m_busyAddresses.cend())
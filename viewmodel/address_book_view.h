@@ -128,9 +128,9 @@ public:
     void setContactSortRole(QString);
 
 public slots:
-    void onAddresses(bool own, const std::vector<beam::wallet::WalletAddress>& addresses);
-    void onTransactions(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&);
-    void onAddressesChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::WalletAddress>& addresses);
+    void onAddresses(bool own, const SharedItems<beam::wallet::WalletAddress>& addresses);
+    void onTransactions(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>&);
+    void onAddressesChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::WalletAddress>& addresses);
 
 signals:
     void contactsChanged();
@@ -42,6 +42,11 @@ bool SwapOfferItem::operator==(const SwapOfferItem& other) const
     return getTxID() == other.getTxID();
 }
 
+auto SwapOfferItem::getKey() const -> TxID
+{
+    return m_offer.m_txId;
+}
+
 auto SwapOfferItem::timeCreated() const -> QDateTime
 {
     beam::Timestamp time;
@@ -100,6 +105,18 @@ auto SwapOfferItem::rate() const -> QString
     return QMLGlobals::divideWithPrecision8(beamui::AmountToUIString(otherCoinAmount), beamui::AmountToUIString(beamAmount));
 }
 
+auto SwapOfferItem::rawRate() const -> double
+{
+    beam::Amount otherCoinAmount =
+        isSendBeam() ? rawAmountReceive() : rawAmountSend();
+    beam::Amount beamAmount =
+        isSendBeam() ? rawAmountSend() : rawAmountReceive();
+
+    if (!beamAmount) return 0;
+
+    return static_cast<double>(otherCoinAmount) / static_cast<double>(beamAmount);
+}
+
 auto SwapOfferItem::amountSend() const -> QString
 {
     auto coinType = isSendBeam()        
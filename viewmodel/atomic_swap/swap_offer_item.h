@@ -14,22 +14,20 @@
 
 #pragma once
 
-#include <QObject>
 #include <QDateTime>
 #include "model/wallet_model.h"
 #include "viewmodel/ui_helpers.h"
 
 using namespace beam::wallet;
 
-class SwapOfferItem : public QObject
+class SwapOfferItem
 {
-    Q_OBJECT
-
 public:
     SwapOfferItem() = default;
     SwapOfferItem(const SwapOffer& offer, bool isOwn, const QDateTime& timeExpiration);
     bool operator==(const SwapOfferItem& other) const;
 
+    auto getKey() const -> TxID;
     auto timeCreated() const -> QDateTime;
     auto timeExpiration() const -> QDateTime;
     auto amountSend() const -> QString;
@@ -40,18 +38,17 @@ public:
 
     auto rawAmountSend() const -> beam::Amount;
     auto rawAmountReceive() const -> beam::Amount;
+    auto rawRate() const -> double;
 
     auto getTxParameters() const -> TxParameters;
     auto getTxID() const -> TxID;
     auto getSwapCoinName() const -> QString;
 
-signals:
-
 private:
     auto getSwapCoinType() const -> beamui::Currencies;
 
     beam::wallet::SwapOffer m_offer;          /// TxParameters subclass
-    bool m_isOwnOffer;          /// indicates if offer belongs to this wallet
-    bool m_isBeamSide;          /// pay beam to receive other coin
+    bool m_isOwnOffer = false;  /// indicates if offer belongs to this wallet
+    bool m_isBeamSide = false;  /// pay beam to receive other coin
     QDateTime m_timeExpiration;
 };
@@ -45,7 +45,7 @@ QHash<int, QByteArray> SwapOffersList::roleNames() const
 
 QVariant SwapOffersList::data(const QModelIndex &index, int role) const
 {
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_list.size())
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
     {
        return QVariant();
     }
@@ -54,53 +54,82 @@ QVariant SwapOffersList::data(const QModelIndex &index, int role) const
     switch (static_cast<Roles>(role))
     {
         case Roles::TimeCreated:
-            return value->timeCreated().toString(Qt::SystemLocaleShortDate);
+            return value.timeCreated().toString(Qt::SystemLocaleShortDate);
         case Roles::TimeCreatedSort:
-            return value->timeCreated();
+            return value.timeCreated();
 
         case Roles::AmountSend:
-            return value->amountSend();
+            return value.amountSend();
 
         case Roles::AmountSendSort:
-            return static_cast<qulonglong>(value->rawAmountSend());
+            return static_cast<qulonglong>(value.rawAmountSend());
 
         case Roles::AmountReceive:
-            return value->amountReceive();
+            return value.amountReceive();
 
         case Roles::AmountReceiveSort:
-            return static_cast<qulonglong>(value->rawAmountReceive());
+            return static_cast<qulonglong>(value.rawAmountReceive());
 
         case Roles::Rate:
         case Roles::RateSort:
-            return value->rate();
+            return value.rate();
 
         case Roles::Expiration:
-            return value->timeExpiration().toString(Qt::SystemLocaleShortDate);
+            return value.timeExpiration().toString(Qt::SystemLocaleShortDate);
         case Roles::ExpirationSort:
-            return value->timeExpiration();
+            return value.timeExpiration();
 
         case Roles::SwapCoin:
-            return value->getSwapCoinName();
+            return value.getSwapCoinName();
 
         case Roles::IsOwnOffer:
-            return value->isOwnOffer();
+            return value.isOwnOffer();
 
         case Roles::IsSendBeam:
-            return value->isSendBeam();
+            return value.isSendBeam();
 
         case Roles::RawTxID:
-            return QVariant::fromValue(value->getTxID());
+            return QVariant::fromValue(value.getTxID());
 
         case Roles::RawTxParameters:
-            return QVariant::fromValue(value->getTxParameters());
+            return QVariant::fromValue(value.getTxParameters());
 
         case Roles::Pair:
         {
-            auto swapCoin = value->getSwapCoinName();
+            auto swapCoin = value.getSwapCoinName();
             const QString beam = "beam";
-            return  value->isSendBeam() ? beam + swapCoin : swapCoin + beam;
+            return  value.isSendBeam() ? beam + swapCoin : swapCoin + beam;
         }
         default:
             return QVariant();
     }
 }
+
+bool SwapOffersList::sortKeys(int role, Qt::CaseSensitivity, std::vector<quint64>& keys) const
+{
+    switch (static_cast<Roles>(role))
+    {
+        case Roles::TimeCreatedSort:
+            keys = keysOf([](const SwapOfferItem& value) { return sortkeys::fromDateTime(value.timeCreated()); });
+            return true;
+
+        case Roles::AmountSendSort:
+            keys = keysOf([](const SwapOfferItem& value) { return static_cast<quint64>(value.rawAmountSend()); });
+            return true;
+
+        case Roles::AmountReceiveSort:
+            keys = keysOf([](const SwapOfferItem& value) { return static_cast<quint64>(value.rawAmountReceive()); });
+            return true;
+
+        case Roles::RateSort:
+            keys = keysOf([](const SwapOfferItem& value) { return sortkeys::fromDouble(value.rawRate()); });
+            return true;
+
+        case Roles::ExpirationSort:
+            keys = keysOf([](const SwapOfferItem& value) { return sortkeys::fromDateTime(value.timeExpiration()); });
+            return true;
+
+        default:
+            return false;
+    }
+}
@@ -17,7 +17,7 @@
 #include "swap_offer_item.h"
 #include "viewmodel/helpers/list_model.h"
 
-class SwapOffersList : public ListModel<std::shared_ptr<SwapOfferItem>>
+class SwapOffersList : public ListModel<SwapOfferItem>
 {
 
     Q_OBJECT
@@ -47,4 +47,5 @@ public:
 
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
+    bool sortKeys(int role, Qt::CaseSensitivity cs, std::vector<quint64>& keys) const override;
 };
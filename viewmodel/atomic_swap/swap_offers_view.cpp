@@ -23,6 +23,21 @@ using namespace beam::wallet;
 using namespace std;
 using namespace beam::bitcoin;
 
+namespace
+{
+    // per coin settings, zero for the coins which have none
+    template <typename Value>
+    Value getCoinValue(const std::map<AtomicSwapCoin, Value>& values, AtomicSwapCoin swapCoinType)
+    {
+        auto it = values.find(swapCoinType);
+        if (it != values.end())
+        {
+            return it->second;
+        }
+        return Value();
+    }
+}
+
 void SwapOffersViewModel::ActiveTxCounters::increment(AtomicSwapCoin swapCoinType)
 {
     ++getCounter(swapCoinType);
@@ -58,16 +73,18 @@ SwapOffersViewModel::SwapOffersViewModel()
         m_selectedCoin(AtomicSwapCoin::Bitcoin),
         m_btcClient(AppModel::getInstance().getBitcoinClient()),
         m_ltcClient(AppModel::getInstance().getLitecoinClient()),
-        m_qtumClient(AppModel::getInstance().getQtumClient())
+        m_qtumClient(AppModel::getInstance().getQtumClient()),
+        m_rowPipeline(this)
 {
     connect(&m_walletModel, SIGNAL(availableChanged()), this, SIGNAL(beamAvailableChanged()));
-    connect(&m_walletModel,
-            SIGNAL(transactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)),
-            SLOT(onTransactionsDataModelChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)));
+    auto& transactionStore = AppModel::getInstance().getTransactionStore();
+    connect(&transactionStore,
+            SIGNAL(swapTransactionsChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>&)),
+            SLOT(onTransactionsDataModelChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>&)));
 
     connect(&m_walletModel,
-            SIGNAL(swapOffersChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::SwapOffer>&)),
-            SLOT(onSwapOffersDataModelChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::SwapOffer>&)));
+            SIGNAL(swapOffersChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::SwapOffer>&)),
+            SLOT(onSwapOffersDataModelChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::SwapOffer>&)));
 
     connect(m_btcClient.get(),  SIGNAL(balanceChanged()), this, SIGNAL(btcAvailableChanged()));
     connect(m_ltcClient.get(), SIGNAL(balanceChanged()), this, SIGNAL(ltcAvailableChanged()));
@@ -79,8 +96,7 @@ SwapOffersViewModel::SwapOffersViewModel()
     monitorAllOffersFitBalance();
 
     m_walletModel.getAsync()->getSwapOffers();
-    m_walletModel.getAsync()->getTransactions();
-    
+
     m_minTxConfirmations.emplace(AtomicSwapCoin::Bitcoin, m_btcClient->GetSettings().GetTxMinConfirmations());
     m_minTxConfirmations.emplace(AtomicSwapCoin::Litecoin, m_ltcClient->GetSettings().GetTxMinConfirmations());
     m_minTxConfirmations.emplace(AtomicSwapCoin::Qtum, m_qtumClient->GetSettings().GetTxMinConfirmations());
@@ -88,6 +104,12 @@ SwapOffersViewModel::SwapOffersViewModel()
     m_blocksPerHour.emplace(AtomicSwapCoin::Bitcoin, m_btcClient->GetSettings().GetBlocksPerHour());
     m_blocksPerHour.emplace(AtomicSwapCoin::Litecoin, m_ltcClient->GetSettings().GetBlocksPerHour());
     m_blocksPerHour.emplace(AtomicSwapCoin::Qtum, m_qtumClient->GetSettings().GetBlocksPerHour());
+
+    // the rows need the coin settings above
+    if (transactionStore.isLoaded())
+    {
+        onTransactionsDataModelChanged(ChangeAction::Reset, transactionStore.getTransactions(TransactionStore::Kind::Swap));
+    }
 }
 
 int SwapOffersViewModel::getSelectedCoin()
@@ -204,37 +226,53 @@ PaymentInfoItem* SwapOffersViewModel::getPaymentInfo(const QVariant& variantTxID
     else return Q_NULLPTR;
 }
 
-void SwapOffersViewModel::onTransactionsDataModelChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& transactions)
+void SwapOffersViewModel::onTransactionsDataModelChanged(beam::wallet::ChangeAction action, const SharedItems<beam::wallet::TxDescription>& transactions)
 {
-    vector<shared_ptr<SwapTxObject>> swapTransactions;
-    vector<shared_ptr<SwapTxObject>> activeTransactions;
-    vector<shared_ptr<SwapTxObject>> inactiveTransactions;
-    swapTransactions.reserve(transactions.size());
-
-    for (const auto& t : transactions)
+    // rows are built on the thread pool with the coin settings of the moment the batch came in
+    m_rowPipeline.post([action, transactions, minTxConfirmations = m_minTxConfirmations, blocksPerHour = m_blocksPerHour]()
     {
-        if (t.GetParameter<TxType>(TxParameterID::TransactionType) == TxType::AtomicSwap)
+        vector<SwapTxObject> swapTransactions;
+        swapTransactions.reserve(transactions->size());
+        for (const auto& t : *transactions)
         {
             auto swapCoinType = t.GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin);
-            uint32_t minTxConfirmations = swapCoinType ? getTxMinConfirmations(*swapCoinType) : 0;
-            double blocksPerHour = swapCoinType ? getBlocksPerHour(*swapCoinType) : 0;
-            auto newItem = make_shared<SwapTxObject>(t, minTxConfirmations, blocksPerHour);
-            swapTransactions.push_back(newItem);
-            if (!newItem->isPending() && newItem->isInProgress())
+            swapTransactions.emplace_back(t,
+                swapCoinType ? getCoinValue(minTxConfirmations, *swapCoinType) : 0,
+                swapCoinType ? getCoinValue(blocksPerHour, *swapCoinType) : 0);
+            if (action != ChangeAction::Removed)
             {
-                activeTransactions.push_back(newItem);
-            }
-            else
-            {
-                inactiveTransactions.push_back(newItem);
+                swapTransactions.back().prepareDisplay();
             }
         }
-    }
+        return swapTransactions;
+    },
+    [this, action](vector<SwapTxObject>& swapTransactions)
+    {
+        applySwapTransactions(action, swapTransactions);
+    });
+}
 
+void SwapOffersViewModel::applySwapTransactions(beam::wallet::ChangeAction action, std::vector<SwapTxObject>& swapTransactions)
+{
     if (swapTransactions.empty())
     {
         return;
     }
+
+    // rows are moved to the list, so the bookkeeping below has to be done before that
+    vector<const SwapTxObject*> activeTransactions;
+    vector<const SwapTxObject*> inactiveTransactions;
+    for (const auto& tx : swapTransactions)
+    {
+        if (!tx.isPending() && tx.isInProgress())
+        {
+            activeTransactions.push_back(&tx);
+        }
+        else
+        {
+            inactiveTransactions.push_back(&tx);
+        }
+    }
     
     auto eraseActive = [this](auto tx)
     {
@@ -259,7 +297,6 @@ void SwapOffersViewModel::onTransactionsDataModelChanged(beam::wallet::ChangeAct
     {
         case ChangeAction::Reset:
             {
-                m_transactionsList.reset(swapTransactions);
                 m_activeTx.clear();
                 m_activeTxCounters.clear();
                 for (auto tx : activeTransactions)
@@ -268,32 +305,32 @@ void SwapOffersViewModel::onTransactionsDataModelChanged(beam::wallet::ChangeAct
                     m_activeTx.emplace(tx->getTxID(), swapCoinType);
                     m_activeTxCounters.increment(swapCoinType);
                 }
+                m_transactionsList.reset(std::move(swapTransactions));
                 break;
             }
 
         case ChangeAction::Removed:
             {
                 m_transactionsList.remove(swapTransactions);
-                for (auto tx : swapTransactions)
+                for (const auto& tx : swapTransactions)
                 {
-                    eraseActive(tx);
+                    eraseActive(&tx);
                 }
                 break;
             }
 
         case ChangeAction::Added:
             {
-                m_transactionsList.insert(swapTransactions);
                 for (auto tx : activeTransactions)
                 {
                     insertActive(tx);
                 }
+                m_transactionsList.insert(std::move(swapTransactions));
                 break;
             }
         
         case ChangeAction::Updated:
             {
-                m_transactionsList.update(swapTransactions);
                 for (auto tx : activeTransactions)
                 {
                     insertActive(tx);
@@ -302,6 +339,7 @@ void SwapOffersViewModel::onTransactionsDataModelChanged(beam::wallet::ChangeAct
                 {
                     eraseActive(tx);
                 }
+                m_transactionsList.update(std::move(swapTransactions));
 
                 break;
             }
@@ -314,12 +352,12 @@ void SwapOffersViewModel::onTransactionsDataModelChanged(beam::wallet::ChangeAct
     emit allTransactionsChanged();
 }
 
-void SwapOffersViewModel::onSwapOffersDataModelChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::SwapOffer>& offers)
+void SwapOffersViewModel::onSwapOffersDataModelChanged(beam::wallet::ChangeAction action, const SharedItems<beam::wallet::SwapOffer>& offers)
 {
-    vector<shared_ptr<SwapOfferItem>> modifiedOffers;
-    modifiedOffers.reserve(offers.size());
+    vector<SwapOfferItem> modifiedOffers;
+    modifiedOffers.reserve(offers->size());
 
-    for (const auto& offer : offers)
+    for (const auto& offer : *offers)
     {
         // Offers without publisherID don't pass validation
         auto peerResponseTime = offer.GetParameter<beam::Height>(beam::wallet::TxParameterID::PeerResponseTime);
@@ -333,22 +371,22 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(beam::wallet::ChangeActio
             timeExpiration = beamui::CalculateExpiresTime(currentHeight, expiresHeight);
         }
 
-        modifiedOffers.push_back(make_shared<SwapOfferItem>(offer, m_walletModel.isOwnAddress(offer.m_publisherId), timeExpiration));
+        modifiedOffers.emplace_back(offer, m_walletModel.isOwnAddress(offer.m_publisherId), timeExpiration);
     }
 
     switch (action)
     {
         case ChangeAction::Reset:
             {
-                m_offersList.reset(modifiedOffers);
+                m_offersList.reset(std::move(modifiedOffers));
                 resetAllOffersFitBalance();
                 break;
             }
 
         case ChangeAction::Added:
             {
-                m_offersList.insert(modifiedOffers);
                 insertAllOffersFitBalance(modifiedOffers);
+                m_offersList.insert(std::move(modifiedOffers));
                 break;
             }
 
@@ -357,7 +395,7 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(beam::wallet::ChangeActio
                 for (const auto& modifiedOffer: modifiedOffers)
                 {
                     emit offerRemovedFromTable(
-                        QVariant::fromValue(modifiedOffer->getTxID()));
+                        QVariant::fromValue(modifiedOffer.getTxID()));
                 }
                 m_offersList.remove(modifiedOffers);
                 removeAllOffersFitBalance(modifiedOffers);
@@ -375,16 +413,16 @@ void SwapOffersViewModel::onSwapOffersDataModelChanged(beam::wallet::ChangeActio
 void SwapOffersViewModel::resetAllOffersFitBalance()
 {
     auto offersCount = m_offersList.rowCount();
-    std::vector<std::shared_ptr<SwapOfferItem>> offersListFitBalance;
+    std::vector<SwapOfferItem> offersListFitBalance;
     offersListFitBalance.reserve(offersCount);
 
     for(int i = 0; i < offersCount; ++i)
     {
         const auto&it = m_offersList.get(i);
-        if (isOfferFitBalance(*it))
+        if (isOfferFitBalance(it))
             offersListFitBalance.push_back(it);
     }
-    m_offersListFitBalance.reset(offersListFitBalance);
+    m_offersListFitBalance.reset(std::move(offersListFitBalance));
     emit allOffersFitBalanceChanged();
 }
 
@@ -467,32 +505,32 @@ bool SwapOffersViewModel::isOfferFitBalance(const SwapOfferItem& offer)
 }
 
 void SwapOffersViewModel::insertAllOffersFitBalance(
-    const std::vector<std::shared_ptr<SwapOfferItem>>& offers)
+    const std::vector<SwapOfferItem>& offers)
 {
-    std::vector<std::shared_ptr<SwapOfferItem>> fitBalanceOffers;
+    std::vector<SwapOfferItem> fitBalanceOffers;
     fitBalanceOffers.reserve(offers.size());
 
     std::copy_if(offers.begin(), offers.end(),
                  std::back_inserter(fitBalanceOffers),
-                 [this] (const std::shared_ptr<SwapOfferItem>& it)
+                 [this] (const SwapOfferItem& it)
                  {
-                     return isOfferFitBalance(*it);
+                     return isOfferFitBalance(it);
                  });
-    m_offersListFitBalance.insert(fitBalanceOffers);
+    m_offersListFitBalance.insert(std::move(fitBalanceOffers));
     emit allOffersFitBalanceChanged();
 }
 
 void SwapOffersViewModel::removeAllOffersFitBalance(
-    const std::vector<std::shared_ptr<SwapOfferItem>>& offers)
+    const std::vector<SwapOfferItem>& offers)
 {
-    std::vector<std::shared_ptr<SwapOfferItem>> fitBalanceOffers;
+    std::vector<SwapOfferItem> fitBalanceOffers;
     fitBalanceOffers.reserve(offers.size());
 
     std::copy_if(offers.begin(), offers.end(),
                  std::back_inserter(fitBalanceOffers),
-                 [this] (const std::shared_ptr<SwapOfferItem>& it)
+                 [this] (const SwapOfferItem& it)
                  {
-                     return isOfferFitBalance(*it);
+                     return isOfferFitBalance(it);
                  });
     m_offersListFitBalance.remove(fitBalanceOffers);
     emit allOffersFitBalanceChanged();    
@@ -527,23 +565,3 @@ bool SwapOffersViewModel::hasActiveTx(const std::string& swapCoin) const
 
     return false;
 }
-
-uint32_t SwapOffersViewModel::getTxMinConfirmations(beam::wallet::AtomicSwapCoin swapCoinType)
-{
-    auto it = m_minTxConfirmations.find(swapCoinType);
-    if (it != m_minTxConfirmations.end())
-    {
-        return it->second;
-    }
-    return 0;
-}
-
-double SwapOffersViewModel::getBlocksPerHour(AtomicSwapCoin swapCoinType)
-{
-    auto it = m_blocksPerHour.find(swapCoinType);
-    if (it != m_blocksPerHour.end())
-    {
-        return it->second;
-    }
-    return 0;
-}
@@ -21,6 +21,7 @@
 #include "model/swap_coin_client_model.h"
 #include "swap_offers_list.h"
 #include "swap_tx_object_list.h"
+#include "viewmodel/helpers/row_pipeline.h"
 
 using namespace beam::wallet;
 
@@ -79,10 +80,10 @@ public:
 public slots:
     void onTransactionsDataModelChanged(
         beam::wallet::ChangeAction action,
-        const std::vector<beam::wallet::TxDescription>& transactions);
+        const SharedItems<beam::wallet::TxDescription>& transactions);
     void onSwapOffersDataModelChanged(
         beam::wallet::ChangeAction action,
-        const std::vector<beam::wallet::SwapOffer>& offers);
+        const SharedItems<beam::wallet::SwapOffer>& offers);
     void resetAllOffersFitBalance();
 
 signals:
@@ -100,15 +101,14 @@ signals:
     void offerRemovedFromTable(QVariant variantTxID);
 
 private:
+    void applySwapTransactions(beam::wallet::ChangeAction action, std::vector<SwapTxObject>& swapTransactions);
     void monitorAllOffersFitBalance();
     bool isOfferFitBalance(const SwapOfferItem& offer);
     void insertAllOffersFitBalance(
-        const std::vector<std::shared_ptr<SwapOfferItem>>& offers);
+        const std::vector<SwapOfferItem>& offers);
     void removeAllOffersFitBalance(
-        const std::vector<std::shared_ptr<SwapOfferItem>>& offers);
+        const std::vector<SwapOfferItem>& offers);
     bool hasActiveTx(const std::string& swapCoin) const;
-    uint32_t getTxMinConfirmations(AtomicSwapCoin swapCoinType);
-    double getBlocksPerHour(AtomicSwapCoin swapCoinType);
 
     WalletModel& m_walletModel;
     
@@ -137,4 +137,5 @@ private:
     std::map<beam::wallet::TxID, beam::wallet::AtomicSwapCoin> m_activeTx;
     std::map<AtomicSwapCoin, uint32_t> m_minTxConfirmations;
     std::map<AtomicSwapCoin, double> m_blocksPerHour;
+    RowPipeline<std::vector<SwapTxObject>> m_rowPipeline;
 };
@@ -121,15 +121,8 @@ namespace
     }
 }
 
-SwapTxObject::SwapTxObject(QObject* parent)
-        : TxObject(parent),
-          m_isBeamSide(boost::none),
-          m_swapCoin(boost::none)
-{
-}
-
-SwapTxObject::SwapTxObject(const TxDescription& tx, uint32_t minTxConfirmations, double blocksPerHour, QObject* parent/* = nullptr*/)
-        : TxObject(tx, parent),
+SwapTxObject::SwapTxObject(const TxDescription& tx, uint32_t minTxConfirmations, double blocksPerHour)
+        : TxObject(tx),
           m_isBeamSide(m_tx.GetParameter<bool>(TxParameterID::AtomicSwapIsBeamSide)),
           m_swapCoin(m_tx.GetParameter<AtomicSwapCoin>(TxParameterID::AtomicSwapCoin)),
           m_minTxConfirmations(minTxConfirmations),
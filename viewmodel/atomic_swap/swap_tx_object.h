@@ -17,11 +17,9 @@
 
 class SwapTxObject : public TxObject
 {
-    Q_OBJECT
-
 public:
-    SwapTxObject(QObject* parent = nullptr);
-    SwapTxObject(const beam::wallet::TxDescription& tx, uint32_t minTxConfirmations, double blocksPerHour, QObject* parent = nullptr);
+    SwapTxObject() = default;
+    SwapTxObject(const beam::wallet::TxDescription& tx, uint32_t minTxConfirmations, double blocksPerHour);
     bool operator==(const SwapTxObject& other) const;
 
     auto getSentAmountWithCurrency() const -> QString;
@@ -62,8 +60,6 @@ public:
     bool isCanceled() const override;
     bool isFailed() const override;
 
-signals:
-
 private:
     auto getSwapAmountValue(bool sent) const -> beam::Amount;
     auto getSwapAmountWithCurrency(bool sent) const -> QString;
@@ -13,9 +13,71 @@
 // limitations under the License.
 
 #include "swap_tx_object_list.h"
+#include "model/app_model.h"
+
+namespace
+{
+
+using TypedKey = quint64 (*)(const SwapTxObject&);
+
+// sort roles with numeric keys, the key of a row doesn't depend on the other rows
+TypedKey typedKeyOf(int role)
+{
+    switch (static_cast<SwapTxObjectList::Roles>(role))
+    {
+        case SwapTxObjectList::Roles::TimeCreatedSort:
+            return [](const SwapTxObject& value) { return static_cast<quint64>(value.timeCreated()); };
+
+        case SwapTxObjectList::Roles::AmountGeneralWithCurrencySort:
+        case SwapTxObjectList::Roles::AmountGeneralSort:
+            return [](const SwapTxObject& value) { return static_cast<quint64>(value.getAmountValue()); };
+
+        case SwapTxObjectList::Roles::AmountSendWithCurrencySort:
+        case SwapTxObjectList::Roles::AmountReceiveWithCurrencySort:
+            return [](const SwapTxObject& value)
+            {
+                return value.isBeamSideSwap()
+                    ? static_cast<quint64>(value.getSentAmountValue())
+                    : static_cast<quint64>(value.getReceivedAmountValue());
+            };
+
+        case SwapTxObjectList::Roles::AmountSendSort:
+            return [](const SwapTxObject& value) { return static_cast<quint64>(value.getSentAmountValue()); };
+
+        case SwapTxObjectList::Roles::AmountReceiveSort:
+            return [](const SwapTxObject& value) { return static_cast<quint64>(value.getReceivedAmountValue()); };
+
+        default:
+            return nullptr;
+    }
+}
+
+using SortText = QString (*)(const SwapTxObject&);
+
+// sort roles with collated text keys, the position of a text depends on all the rows
+SortText sortTextOf(int role)
+{
+    switch (static_cast<SwapTxObjectList::Roles>(role))
+    {
+        case SwapTxObjectList::Roles::AddressFromSort:
+            return [](const SwapTxObject& value) { return value.getAddressFrom(); };
+
+        case SwapTxObjectList::Roles::AddressToSort:
+            return [](const SwapTxObject& value) { return value.getAddressTo(); };
+
+        case SwapTxObjectList::Roles::StatusSort:
+            return [](const SwapTxObject& value) { return value.getStatus(); };
+
+        default:
+            return nullptr;
+    }
+}
+
+}  // namespace
 
 SwapTxObjectList::SwapTxObjectList()
 {
+    connect(&AppModel::getInstance().getSettings(), SIGNAL(localeChanged()), SLOT(onLocaleChanged()));
 }
 
 auto SwapTxObjectList::roleNames() const -> QHash<int, QByteArray>
@@ -84,7 +146,7 @@ auto SwapTxObjectList::roleNames() const -> QHash<int, QByteArray>
 
 auto SwapTxObjectList::data(const QModelIndex &index, int role) const -> QVariant
 {
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_list.size())
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
     {
        return QVariant();
     }
@@ -93,178 +155,213 @@ auto SwapTxObjectList::data(const QModelIndex &index, int role) const -> QVarian
     switch (static_cast<Roles>(role))
     {
         case Roles::TimeCreated:
-        {
-            QDateTime datetime;
-            datetime.setTime_t(value->timeCreated());
-            return datetime.toString(Qt::SystemLocaleShortDate);
-        }
+            return value.getTimeCreated();
         case Roles::TimeCreatedSort:
         {
-            return static_cast<qulonglong>(value->timeCreated());
+            return static_cast<qulonglong>(value.timeCreated());
         }
 
         case Roles::AmountGeneralWithCurrency:
-            return value->getAmountWithCurrency();
+            return value.getAmountWithCurrency();
         case Roles::AmountGeneralWithCurrencySort:
-            return static_cast<qulonglong>(value->getAmountValue());
+            return static_cast<qulonglong>(value.getAmountValue());
         case Roles::AmountGeneral:
-            return value->getAmount();
+            return value.getAmount();
         case Roles::AmountGeneralSort:
-            return static_cast<qulonglong>(value->getAmountValue());
+            return static_cast<qulonglong>(value.getAmountValue());
 
         case Roles::AddressFrom:
         case Roles::AddressFromSort:
-            return value->getAddressFrom();
+            return value.getAddressFrom();
 
         case Roles::AddressTo:
         case Roles::AddressToSort:
-            return value->getAddressTo();
+            return value.getAddressTo();
 
         case Roles::Status:
         case Roles::StatusSort:
-            return value->getStatus();
+            return value.getStatus();
 
         case Roles::Fee:
-            return value->getFee();
+            return value.getFee();
 
         case Roles::Comment:
-            return value->getComment();
+            return value.getComment();
 
         case Roles::TxID:
-            return value->getTransactionID();
+            return value.getTransactionID();
 
         case Roles::KernelID:
-            return value->getKernelID();
+            return value.getKernelID();
 
         case Roles::FailureReason:
-            return value->getFailureReason();
+            return value.getFailureReason();
 
         case Roles::IsCancelAvailable:
-            return value->isCancelAvailable();
+            return value.isCancelAvailable();
 
         case Roles::IsDeleteAvailable:
-            return value->isDeleteAvailable();
+            return value.isDeleteAvailable();
 
         case Roles::IsSelfTransaction:
-            return value->isSelfTx();
+            return value.isSelfTx();
 
         case Roles::IsIncome:
-            return value->isIncome();
+            return value.isIncome();
 
         case Roles::IsInProgress:
-            return value->isInProgress();
+            return value.isInProgress();
 
         case Roles::IsPending:
-            return value->isPending();
+            return value.isPending();
 
         case Roles::IsCompleted:
-            return value->isCompleted();
+            return value.isCompleted();
 
         case Roles::IsCanceled:
-            return value->isCanceled();
+            return value.isCanceled();
 
         case Roles::IsFailed:
-            return value->isFailed();
+            return value.isFailed();
 
         case Roles::IsExpired:
-            return value->isExpired();
+            return value.isExpired();
 
         case Roles::HasPaymentProof:
-            return value->hasPaymentProof();
+            return value.hasPaymentProof();
 
         case Roles::RawTxID:
-            return QVariant::fromValue(value->getTxID());
+            return QVariant::fromValue(value.getTxID());
 
-        case Roles::Search: 
-        {
-            QString r = value->getTransactionID();
-            r.append(" ");
-            r.append(value->getKernelID());
-            r.append(" ");
-            r.append(value->getAddressFrom());
-            r.append(" ");
-            r.append(value->getAddressTo());
-            r.append(" ");
-            r.append(value->getComment());
-            return r;
-        }
+        case Roles::Search:
+            return value.getSearchString();
             
         // atomic swap only roles
 
         case Roles::IsBeamSideSwap:
-            return value->isBeamSideSwap();
+            return value.isBeamSideSwap();
 
         case Roles::IsLockTxProofReceived:
-            return value->isLockTxProofReceived();
+            return value.isLockTxProofReceived();
 
         case Roles::IsRefundTxProofReceived:
-            return value->isRefundTxProofReceived();
+            return value.isRefundTxProofReceived();
             
         case Roles::AmountSendWithCurrency:
-            return value->getSentAmountWithCurrency();
+            return value.getSentAmountWithCurrency();
         case Roles::AmountSendWithCurrencySort:
-            return value->isBeamSideSwap()
-                ? static_cast<qulonglong>(value->getSentAmountValue())
-                : static_cast<qulonglong>(value->getReceivedAmountValue());
+            return value.isBeamSideSwap()
+                ? static_cast<qulonglong>(value.getSentAmountValue())
+                : static_cast<qulonglong>(value.getReceivedAmountValue());
         case Roles::AmountSend:
-            return value->getSentAmount();
+            return value.getSentAmount();
         case Roles::AmountSendSort:
-            return static_cast<qulonglong>(value->getSentAmountValue());
+            return static_cast<qulonglong>(value.getSentAmountValue());
 
         case Roles::AmountReceiveWithCurrency:
-            return value->getReceivedAmountWithCurrency();
+            return value.getReceivedAmountWithCurrency();
         case Roles::AmountReceiveWithCurrencySort:
-            return value->isBeamSideSwap()
-                    ? static_cast<qulonglong>(value->getSentAmountValue())
-                    : static_cast<qulonglong>(value->getReceivedAmountValue());
+            return value.isBeamSideSwap()
+                    ? static_cast<qulonglong>(value.getSentAmountValue())
+                    : static_cast<qulonglong>(value.getReceivedAmountValue());
         case Roles::AmountReceive:
-            return value->getReceivedAmount();
+            return value.getReceivedAmount();
         case Roles::AmountReceiveSort:
-            return static_cast<qulonglong>(value->getReceivedAmountValue());
+            return static_cast<qulonglong>(value.getReceivedAmountValue());
 
         case Roles::Token:
-            return value->getToken();
+            return value.getToken();
 
         case Roles::SwapCoin:
-            return value->getSwapCoinName();
+            return value.getSwapCoinName();
 
         case Roles::SwapCoinFeeRate:
-            return value->getSwapCoinFeeRate();
+            return value.getSwapCoinFeeRate();
 
         case Roles::SwapCoinFee:
-            return value->getSwapCoinFee();
+            return value.getSwapCoinFee();
 
         case Roles::SwapCoinLockTxId:
-            return value->getSwapCoinLockTxId();
+            return value.getSwapCoinLockTxId();
 
         case Roles::SwapCoinLockTxConfirmations:
-            return value->getSwapCoinLockTxConfirmations();
+            return value.getSwapCoinLockTxConfirmations();
 
         case Roles::SwapCoinRedeemTxId:
-            return value->getSwapCoinRedeemTxId();
+            return value.getSwapCoinRedeemTxId();
 
         case Roles::SwapCoinRedeemTxConfirmations:
-            return value->getSwapCoinRedeemTxConfirmations();
+            return value.getSwapCoinRedeemTxConfirmations();
 
         case Roles::SwapCoinRefundTxId:
-            return value->getSwapCoinRefundTxId();
+            return value.getSwapCoinRefundTxId();
 
         case Roles::SwapCoinRefundTxConfirmations:
-            return value->getSwapCoinRefundTxConfirmations();
+            return value.getSwapCoinRefundTxConfirmations();
 
         case Roles::BeamLockTxKernelId:
-            return value->getBeamLockTxKernelId();
+            return value.getBeamLockTxKernelId();
 
         case Roles::BeamRedeemTxKernelId:
-            return value->getBeamRedeemTxKernelId();
+            return value.getBeamRedeemTxKernelId();
 
         case Roles::BeamRefundTxKernelId:
-            return value->getBeamRefundTxKernelId();
+            return value.getBeamRefundTxKernelId();
 
         case Roles::StateDetails:
-            return value->getStateDetails();
+            return value.getStateDetails();
 
         default:
             return QVariant();
     }
 }
+
+auto SwapTxObjectList::sortKeys(int role, Qt::CaseSensitivity cs, std::vector<quint64>& keys) const -> bool
+{
+    if (auto key = typedKeyOf(role))
+    {
+        keys = keysOf(key);
+        return true;
+    }
+    if (auto text = sortTextOf(role))
+    {
+        keys = collatedKeysOf(text, cs);
+        return true;
+    }
+    return false;
+}
+
+auto SwapTxObjectList::updateSortKeys(int role, int first, int last, std::vector<quint64>& keys) const -> bool
+{
+    // collated texts get their positions among all the rows, they are built again
+    if (auto key = typedKeyOf(role))
+    {
+        updateKeysOf(key, first, last, keys);
+        return true;
+    }
+    return false;
+}
+
+auto SwapTxObjectList::sortTexts(int role, std::vector<QString>& texts) const -> bool
+{
+    if (auto text = sortTextOf(role))
+    {
+        texts = textsOf(text);
+        return true;
+    }
+    return false;
+}
+
+void SwapTxObjectList::onLocaleChanged()
+{
+    // formatted values depend on the locale, views have to re-read all the rows
+    TxObject::retranslate();
+    for (auto& value : m_list)
+    {
+        value.resetDisplayCache();
+    }
+    if (!m_list.empty())
+    {
+        emit dataChanged(index(0), index(rowCount() - 1));
+    }
+}
@@ -17,7 +17,7 @@
 #include "swap_tx_object.h"
 #include "viewmodel/helpers/list_model.h"
 
-class SwapTxObjectList : public ListModel<std::shared_ptr<SwapTxObject>>
+class SwapTxObjectList : public ListModel<SwapTxObject>
 {
 
     Q_OBJECT
@@ -87,4 +87,10 @@ public:
 
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
+    bool sortKeys(int role, Qt::CaseSensitivity cs, std::vector<quint64>& keys) const override;
+    bool updateSortKeys(int role, int first, int last, std::vector<quint64>& keys) const override;
+    bool sortTexts(int role, std::vector<QString>& texts) const override;
+
+private slots:
+    void onLocaleChanged();
 };
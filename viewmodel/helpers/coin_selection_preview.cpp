@@ -0,0 +1,110 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "coin_selection_preview.h"
+#include <iterator>
+
+using namespace beam;
+using namespace beam::wallet;
+
+bool CoinSelectionPreview::isLoaded() const
+{
+    return m_loaded;
+}
+
+void CoinSelectionPreview::reset(const std::vector<Coin::ID>& spendable)
+{
+    m_spendable.clear();
+    m_amounts.clear();
+    for (const auto& id : spendable)
+    {
+        m_spendable.emplace(id, id.m_Value);
+        m_amounts.insert(id.m_Value);
+    }
+    m_loaded = true;
+}
+
+void CoinSelectionPreview::apply(ChangeAction action, const std::vector<Coin>& coins)
+{
+    if (action == ChangeAction::Reset)
+    {
+        m_spendable.clear();
+        m_amounts.clear();
+        m_loaded = true;
+    }
+
+    for (const auto& coin : coins)
+    {
+        auto it = m_spendable.find(coin.m_ID);
+        if (it != m_spendable.end())
+        {
+            m_amounts.erase(m_amounts.find(it->second));
+            m_spendable.erase(it);
+        }
+
+        // only the coins the wallet can take as inputs right now
+        if (action != ChangeAction::Removed && coin.m_status == Coin::Available)
+        {
+            m_spendable.emplace(coin.m_ID, coin.m_ID.m_Value);
+            m_amounts.insert(coin.m_ID.m_Value);
+        }
+    }
+}
+
+// a coin of exactly the amount is taken alone, otherwise the smaller coins are taken
+// from the largest one down, unless the smallest single coin above the amount leaves less change
+CoinSelectionPreview::Selection CoinSelectionPreview::select(Amount amount) const
+{
+    Selection selection;
+    selection.resultingUtxos = m_amounts.size();
+    if (amount == 0)
+    {
+        return selection;
+    }
+
+    if (m_amounts.find(amount) != m_amounts.end())
+    {
+        selection.inputs = 1;
+        selection.resultingUtxos = m_amounts.size() - 1;
+        return selection;
+    }
+
+    const auto larger = m_amounts.upper_bound(amount);
+
+    Amount sum = 0;
+    size_t inputs = 0;
+    for (auto it = std::make_reverse_iterator(m_amounts.lower_bound(amount)); it != m_amounts.rend() && sum < amount; ++it)
+    {
+        sum += *it;
+        ++inputs;
+    }
+
+    if (sum >= amount && (larger == m_amounts.end() || sum - amount <= *larger - amount))
+    {
+        selection.change = sum - amount;
+        selection.inputs = inputs;
+    }
+    else if (larger != m_amounts.end())
+    {
+        selection.change = *larger - amount;
+        selection.inputs = 1;
+    }
+    else
+    {
+        return selection;
+    }
+
+    selection.resultingUtxos = m_amounts.size() - selection.inputs + (selection.change > 0 ? 1 : 0);
+    return selection;
+}
@@ -0,0 +1,47 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "wallet/client/wallet_client.h"
+#include <map>
+#include <set>
+#include <vector>
+
+// Copy of the spendable coins of the wallet which lets the send screen show the change
+// and the inputs of a transaction while the amount is typed, without asking the wallet thread.
+// It follows the selection rule of the wallet, the wallet still has the last word on sending.
+class CoinSelectionPreview
+{
+public:
+    struct Selection
+    {
+        beam::Amount change = 0;
+        size_t inputs = 0;
+        // coins of the wallet once the transaction is sent, the change included
+        size_t resultingUtxos = 0;
+    };
+
+    bool isLoaded() const;
+    // the coins the wallet can take as inputs right now
+    void reset(const std::vector<beam::wallet::Coin::ID>& spendable);
+    void apply(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& coins);
+    Selection select(beam::Amount amount) const;
+
+private:
+    bool m_loaded = false;
+    std::map<beam::wallet::Coin::ID, beam::Amount> m_spendable;
+    // amounts of m_spendable in ascending order
+    std::multiset<beam::Amount> m_amounts;
+};
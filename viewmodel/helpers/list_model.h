@@ -15,26 +15,157 @@
 #pragma once
 
 #include <QAbstractListModel>
+#include <QHash>
+#include <QVector>
+#include "sort_keys.h"
+#include <algorithm>
+#include <array>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Hash of the row keys, specialize it for the key types std::hash doesn't know about
+template <typename K>
+struct ListModelKeyHash : public std::hash<K>
+{
+};
+
+template <size_t N>
+struct ListModelKeyHash<std::array<uint8_t, N>>
+{
+    size_t operator()(const std::array<uint8_t, N>& key) const
+    {
+        return qHashBits(key.data(), key.size());
+    }
+};
+
+// Batch operations on a key to row index, shared by ListModel and the models
+// which keep their rows in another shape
+namespace listmodel
+{
+    template <typename Key>
+    using RowIndex = std::unordered_map<Key, int, ListModelKeyHash<Key>>;
+
+    // rows which keys are not in the snapshot, in ascending order
+    template <typename Items, typename ItemKey, typename RowKey>
+    std::vector<int> rowsMissingFrom(const Items& items, ItemKey itemKey, int rowCount, RowKey rowKey)
+    {
+        using Key = std::decay_t<decltype(itemKey(*std::begin(items)))>;
+        std::unordered_set<Key, ListModelKeyHash<Key>> keys;
+        keys.reserve(items.size());
+        for (const auto& item : items)
+        {
+            keys.insert(itemKey(item));
+        }
+
+        std::vector<int> rows;
+        for (int row = 0; row < rowCount; ++row)
+        {
+            if (keys.find(rowKey(row)) == keys.end())
+            {
+                rows.push_back(row);
+            }
+        }
+        return rows;
+    }
+
+    // rows of the items which are in the index
+    template <typename Key, typename Items, typename ItemKey>
+    std::vector<int> rowsOf(const RowIndex<Key>& index, const Items& items, ItemKey itemKey)
+    {
+        std::vector<int> rows;
+        rows.reserve(items.size());
+        for (const auto& item : items)
+        {
+            auto it = index.find(itemKey(item));
+            if (it != index.end())
+            {
+                rows.push_back(it->second);
+            }
+        }
+        return rows;
+    }
+
+    // keys are unique, so the items which are not in the index yet get the rows after the current ones
+    // in the batch order, the others are paired with the rows they replace
+    template <typename Key, typename Items, typename ItemKey>
+    void splitBatch(RowIndex<Key>& index, int rowCount, const Items& items, ItemKey itemKey,
+                    std::vector<size_t>& newItems, std::vector<std::pair<int, size_t>>& changedItems)
+    {
+        newItems.reserve(items.size());
+        for (size_t i = 0; i < items.size(); ++i)
+        {
+            auto p = index.emplace(itemKey(items[i]), rowCount + static_cast<int>(newItems.size()));
+            if (p.second)
+            {
+                newItems.push_back(i);
+            }
+            else
+            {
+                changedItems.emplace_back(p.first->second, i);
+            }
+        }
+    }
+
+    // calls removeRange(first, last) once per contiguous range of the rows, bottom up, so the ranges
+    // which are still to be removed keep their positions; returns the first row which has moved
+    // and has to be reindexed, -1 if nothing was removed
+    template <typename F>
+    int removeRanges(std::vector<int> rows, F removeRange)
+    {
+        if (rows.empty())
+        {
+            return -1;
+        }
+
+        std::sort(rows.begin(), rows.end(), std::greater<int>());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+        size_t i = 0;
+        while (i < rows.size())
+        {
+            const int last = rows[i];
+            int first = last;
+            for (++i; i < rows.size() && rows[i] == first - 1; ++i)
+            {
+                first = rows[i];
+            }
+            removeRange(first, last);
+        }
+        return rows.back();
+    }
+
+    // refreshes the index for the rows starting from the given one
+    template <typename Key, typename RowKey>
+    void reindex(RowIndex<Key>& index, int from, int rowCount, RowKey rowKey)
+    {
+        for (int row = from; row < rowCount; ++row)
+        {
+            index[rowKey(row)] = row;
+        }
+    }
+}
 
 template <typename T>
-class ListModel : public QAbstractListModel
+class ListModel : public QAbstractListModel, public SortKeySource
 {
     template<typename Y>
-    struct Comparator
+    struct KeyOf
     {
-        const Y& value;
-        Comparator(const Y& v) : value{ v } {}
-        constexpr bool operator()(const Y& other) { return value == other; }
+        static auto get(const Y& value) { return value.getKey(); }
     };
 
     template<typename Y>
-    struct Comparator<std::shared_ptr<Y>>
+    struct KeyOf<std::shared_ptr<Y>>
     {
-        std::shared_ptr<Y> value;
-        Comparator(const std::shared_ptr<Y>& v) : value{ v } {}
-        constexpr bool operator()(const std::shared_ptr<Y>& other) { return *value == *other; }
+        static auto get(const std::shared_ptr<Y>& value) { return value->getKey(); }
     };
+
 public:
+    using Key = std::decay_t<decltype(KeyOf<T>::get(std::declval<const T&>()))>;
+
     ListModel(QObject* pObj = nullptr)
         : QAbstractListModel(pObj)
     {
@@ -46,81 +177,239 @@ public:
         {
             return 0;
         }
-        return m_list.size();
+        return static_cast<int>(m_list.size());
     }
 
-    void insert(const std::vector<T>& items)
+    void insert(std::vector<T> items)
     {
-        if (items.size() == 0)
+        upsert(std::move(items));
+    }
+
+    // applies the snapshot as a diff against the current rows, so delegates,
+    // scroll position and selection of the views survive it
+    void reset(std::vector<T> items)
+    {
+        auto removedRows = listmodel::rowsMissingFrom(items, &ListModel::itemKey, rowCount(),
+                                                      [this](int row) { return itemKey(m_list[row]); });
+
+        // nothing survives, plain model reset is cheaper than the diff
+        if (removedRows.size() == m_list.size())
         {
+            hardReset(std::move(items));
             return;
         }
-        int row = 0;
-        beginInsertRows(QModelIndex(), row, row + int(items.size()) - 1);
-        for (const auto& item : items)
-        {
-            m_list.insert(row, item);
-        }
-        endInsertRows();
+
+        removeBatch(std::move(removedRows));
+        upsert(std::move(items));
     }
 
-    void reset(const std::vector<T>& items)
+    void hardReset(std::vector<T> items)
     {
-        int row = 0;
         beginResetModel();
         m_list.clear();
-        for (const auto& item : items)
+        m_index.clear();
+        m_list.reserve(items.size());
+        for (auto& item : items)
         {
-            m_list.insert(row, item);
+            auto p = m_index.emplace(itemKey(item), rowCount());
+            if (p.second)
+            {
+                m_list.push_back(std::move(item));
+            }
+            else
+            {
+                m_list[p.first->second] = std::move(item);
+            }
         }
         endResetModel();
     }
 
-    T get(int index) const
+    const T& get(int index) const
     {
         return m_list.at(index);
     }
 
     void remove(const std::vector<T>& items)
     {
-        for (const auto& item : items)
+        removeBatch(listmodel::rowsOf(m_index, items, &ListModel::itemKey));
+    }
+
+    void removeKeys(const std::vector<Key>& keys)
+    {
+        removeBatch(listmodel::rowsOf(m_index, keys, [](const Key& key) -> const Key& { return key; }));
+    }
+
+    void update(std::vector<T> items)
+    {
+        upsert(std::move(items));
+    }
+
+    bool sortKeys(int, Qt::CaseSensitivity, std::vector<quint64>&) const override
+    {
+        return false;
+    }
+
+protected:
+    // key of every row, in the row order
+    template <typename F>
+    std::vector<quint64> keysOf(F key) const
+    {
+        std::vector<quint64> keys;
+        keys.reserve(m_list.size());
+        for (const auto& item : m_list)
+        {
+            keys.push_back(key(item));
+        }
+        return keys;
+    }
+
+    // keys of the rows [first, last] written over their previous ones
+    template <typename F>
+    void updateKeysOf(F key, int first, int last, std::vector<quint64>& keys) const
+    {
+        for (int row = first; row <= last; ++row)
+        {
+            keys[row] = key(m_list[row]);
+        }
+    }
+
+    // text of every row, in the row order
+    template <typename F>
+    std::vector<QString> textsOf(F text) const
+    {
+        std::vector<QString> texts;
+        texts.reserve(m_list.size());
+        for (const auto& item : m_list)
+        {
+            texts.push_back(text(item));
+        }
+        return texts;
+    }
+
+    // text of the given rows, in the order of the rows
+    template <typename F>
+    std::vector<QString> textsOf(F text, const std::vector<int>& rows) const
+    {
+        std::vector<QString> texts;
+        texts.reserve(rows.size());
+        for (int row : rows)
+        {
+            texts.push_back(text(m_list[row]));
+        }
+        return texts;
+    }
+
+    // text of every row turned into its position in the collation order
+    template <typename F>
+    std::vector<quint64> collatedKeysOf(F text, Qt::CaseSensitivity cs) const
+    {
+        return sortkeys::collate(textsOf(text), cs);
+    }
+
+    // keys are unique, so the items which are not in the model yet are appended
+    // in the batch order with a single notification and the others replace their rows
+    void upsert(std::vector<T> items)
+    {
+        std::vector<size_t> newItems;
+        std::vector<std::pair<int, size_t>> changedItems;
+        listmodel::splitBatch(m_index, rowCount(), items, &ListModel::itemKey, newItems, changedItems);
+
+        if (!newItems.empty())
         {
-            auto it = std::find_if(std::begin(m_list), std::end(m_list), Comparator<T>(item));
+            const int first = rowCount();
+            beginInsertRows(QModelIndex(), first, first + static_cast<int>(newItems.size()) - 1);
+            m_list.reserve(m_list.size() + newItems.size());
+            for (auto i : newItems)
+            {
+                m_list.push_back(std::move(items[i]));
+            }
+            endInsertRows();
+        }
 
-            if (it != std::end(m_list))
+        if (!changedItems.empty())
+        {
+            const auto roles = roleNames().keys();
+            for (const auto& [row, i] : changedItems)
             {
-                auto index = m_list.indexOf(*it);
-                beginRemoveRows(QModelIndex(), index, index);
-                m_list.removeAt(index);
-                endRemoveRows();
+                replace(row, std::move(items[i]), roles);
             }
         }
     }
 
-    void update(const std::vector<T>& items)
+    // removes the rows with one notification per contiguous range
+    void removeBatch(std::vector<int> rows)
     {
-        for (const auto& item : items)
+        const int moved = listmodel::removeRanges(std::move(rows), [this](int first, int last)
+        {
+            beginRemoveRows(QModelIndex(), first, last);
+            for (int row = first; row <= last; ++row)
+            {
+                m_index.erase(itemKey(m_list[row]));
+            }
+            m_list.erase(m_list.begin() + first, m_list.begin() + last + 1);
+            endRemoveRows();
+        });
+        if (moved >= 0)
         {
-            auto it = std::find_if(std::begin(m_list), std::end(m_list), Comparator<T>(item));
+            reindex(moved);
+        }
+    }
 
-            // index to add item on last position by default
-            int index = (m_list.count() == 0) ? 0 : m_list.count() - 1;
+    // roles which values differ between the old and the new payload of a row, returns false
+    // if the list can't tell them from the payloads, the values of all the roles are compared then
+    virtual bool changedRoles(const T& /*before*/, const T& /*after*/, QVector<int>& /*roles*/) const
+    {
+        return false;
+    }
 
-            if (it != std::end(m_list))
+    // replaces payload of the row in place, delegates are kept and only the roles
+    // which values have actually changed are reported
+    void replace(int row, T&& item, const QList<int>& roles)
+    {
+        const auto modelIndex = index(row);
+        QVector<int> changed;
+        if (changedRoles(m_list[row], item, changed))
+        {
+            m_list[row] = std::move(item);
+        }
+        else
+        {
+            QVector<QVariant> before;
+            before.reserve(roles.size());
+            for (auto role : roles)
             {
-                index = m_list.indexOf(*it);
+                before.push_back(data(modelIndex, role));
+            }
 
-                beginRemoveRows(QModelIndex(), index, index);
-                m_list.removeAt(index);
-                endRemoveRows();
+            m_list[row] = std::move(item);
+
+            for (int i = 0; i < roles.size(); ++i)
+            {
+                if (data(modelIndex, roles[i]) != before[i])
+                {
+                    changed.push_back(roles[i]);
+                }
             }
+        }
 
-            beginInsertRows(QModelIndex(), index, index);
-            m_list.insert(index, item);
-            endInsertRows();
+        if (!changed.isEmpty())
+        {
+            emit dataChanged(modelIndex, modelIndex, changed);
         }
     }
 
-protected:
-    QList<T> m_list;
+    // refreshes key->row index for the rows starting from the given one
+    void reindex(int from)
+    {
+        listmodel::reindex(m_index, from, rowCount(), [this](int row) { return itemKey(m_list[row]); });
+    }
+
+    static Key itemKey(const T& item)
+    {
+        return KeyOf<T>::get(item);
+    }
+
+    // rows are stored by value and contiguously
+    std::vector<T> m_list;
+    listmodel::RowIndex<Key> m_index;
 };
@@ -0,0 +1,121 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QMutex>
+#include <QObject>
+#include <QRunnable>
+#include <QThreadPool>
+#include <deque>
+#include <functional>
+#include <memory>
+
+// Builds the rows of the incoming batches on the thread pool, one batch at a time,
+// and hands them over on the thread of the receiver in the order the batches came in.
+// The conversion must not touch the receiver, the splice runs in its thread.
+template <typename Rows>
+class RowPipeline
+{
+public:
+    using Convert = std::function<Rows()>;
+    using Splice = std::function<void(Rows&)>;
+
+    explicit RowPipeline(QObject* receiver)
+        : m_state(std::make_shared<State>())
+    {
+        m_state->receiver = receiver;
+    }
+
+    RowPipeline(const RowPipeline&) = delete;
+    RowPipeline& operator=(const RowPipeline&) = delete;
+
+    // batches which are not spliced yet are dropped
+    ~RowPipeline()
+    {
+        QMutexLocker lock(&m_state->mutex);
+        m_state->receiver = nullptr;
+        m_state->jobs.clear();
+    }
+
+    void post(Convert convert, Splice splice)
+    {
+        QMutexLocker lock(&m_state->mutex);
+        m_state->jobs.push_back({ std::move(convert), std::move(splice) });
+        if (!m_state->running)
+        {
+            m_state->running = true;
+            QThreadPool::globalInstance()->start(new Runner(m_state));
+        }
+    }
+
+private:
+    struct Job
+    {
+        Convert convert;
+        Splice splice;
+    };
+
+    struct State
+    {
+        QMutex mutex;
+        QObject* receiver = nullptr;
+        std::deque<Job> jobs;
+        bool running = false;
+    };
+
+    class Runner : public QRunnable
+    {
+    public:
+        explicit Runner(std::shared_ptr<State> state)
+            : m_state(std::move(state))
+        {
+        }
+
+        void run() override
+        {
+            for (;;)
+            {
+                Job job;
+                {
+                    QMutexLocker lock(&m_state->mutex);
+                    if (m_state->jobs.empty() || !m_state->receiver)
+                    {
+                        m_state->running = false;
+                        return;
+                    }
+                    job = std::move(m_state->jobs.front());
+                    m_state->jobs.pop_front();
+                }
+
+                auto rows = std::make_shared<Rows>(job.convert());
+
+                QMutexLocker lock(&m_state->mutex);
+                if (m_state->receiver)
+                {
+                    // queued calls to one receiver are delivered in the order they were made
+                    QMetaObject::invokeMethod(m_state->receiver, [splice = std::move(job.splice), rows]()
+                    {
+                        splice(*rows);
+                    }, Qt::QueuedConnection);
+                }
+            }
+        }
+
+    private:
+        std::shared_ptr<State> m_state;
+    };
+
+    std::shared_ptr<State> m_state;
+};
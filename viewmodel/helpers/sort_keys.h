@@ -0,0 +1,120 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <QCollator>
+#include <QDateTime>
+#include <QHash>
+#include <QString>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+// Models which can give the sort key of every row as a plain integer,
+// SortFilterProxyModel compares them instead of the role values
+class SortKeySource
+{
+public:
+    virtual ~SortKeySource() = default;
+
+    // fills one key per row in the row order, returns false if the role has no typed keys
+    virtual bool sortKeys(int role, Qt::CaseSensitivity cs, std::vector<quint64>& keys) const = 0;
+
+    // replaces the keys of the rows [first, last] after their data has changed, returns false
+    // if the keys of the role depend on the other rows too and have to be built again
+    virtual bool updateSortKeys(int /*role*/, int /*first*/, int /*last*/, std::vector<quint64>& /*keys*/) const
+    {
+        return false;
+    }
+
+    // texts of the rows for the roles which keys are collated texts, sortkeys::collate turns them
+    // into the keys on any thread; returns false for the other roles
+    virtual bool sortTexts(int /*role*/, std::vector<QString>& /*texts*/) const
+    {
+        return false;
+    }
+
+    // texts of the given rows for a role the rows are filtered by, read from the rows without
+    // a QVariant per row, so they can be matched on any thread; returns false for the other roles
+    virtual bool filterTexts(int /*role*/, const std::vector<int>& /*rows*/, std::vector<QString>& /*texts*/) const
+    {
+        return false;
+    }
+};
+
+namespace sortkeys
+{
+    inline quint64 fromSigned(qint64 value)
+    {
+        return static_cast<quint64>(value) ^ (quint64(1) << 63);
+    }
+
+    // keeps the order of the finite values, negative ones go first
+    inline quint64 fromDouble(double value)
+    {
+        quint64 bits = 0;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return (bits & (quint64(1) << 63)) ? ~bits : bits | (quint64(1) << 63);
+    }
+
+    inline quint64 fromDateTime(const QDateTime& value)
+    {
+        return value.isValid() ? fromSigned(value.toMSecsSinceEpoch()) : 0;
+    }
+
+    // positions of the texts in the collation order of the current locale,
+    // every distinct text gets its collation key once, equal texts get equal keys
+    inline std::vector<quint64> collate(const std::vector<QString>& texts, Qt::CaseSensitivity cs)
+    {
+        QHash<QString, quint64> ranks;
+        ranks.reserve(static_cast<int>(texts.size()));
+        for (const auto& text : texts)
+        {
+            ranks.insert(text, 0);
+        }
+
+        QCollator collator;
+        collator.setCaseSensitivity(cs);
+        std::vector<std::pair<QCollatorSortKey, QString>> distinct;
+        distinct.reserve(ranks.size());
+        for (auto it = ranks.cbegin(); it != ranks.cend(); ++it)
+        {
+            distinct.emplace_back(collator.sortKey(it.key()), it.key());
+        }
+        std::sort(distinct.begin(), distinct.end(), [](const auto& left, const auto& right)
+        {
+            return left.first.compare(right.first) < 0;
+        });
+
+        quint64 rank = 0;
+        for (size_t i = 0; i < distinct.size(); ++i)
+        {
+            if (i > 0 && distinct[i - 1].first.compare(distinct[i].first) != 0)
+            {
+                ++rank;
+            }
+            ranks[distinct[i].second] = rank;
+        }
+
+        std::vector<quint64> keys;
+        keys.reserve(texts.size());
+        for (const auto& text : texts)
+        {
+            keys.push_back(ranks.value(text));
+        }
+        return keys;
+    }
+}
@@ -13,13 +13,215 @@
 // limitations under the License.
 
 #include "sortfilterproxymodel.h"
+#include <QtCore/qdatetime.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qrunnable.h>
+#include <QtCore/qthreadpool.h>
+#include <QtQml/qjsengine.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <future>
+#include <numeric>
+#include <thread>
 
-SortFilterProxyModel::SortFilterProxyModel(QObject *parent) : QSortFilterProxyModel(parent), m_complete(false)
+namespace
+{
+    const size_t kMaxFilterHistory = 8;
+    const signed char kNotTested = -1;
+    // smaller sources are sorted and filtered synchronously even in the asynchronous mode
+    const int kAsyncMinRows = 1000;
+    const size_t kParallelSortChunk = 10000;
+
+    // every role becomes a getter, which replaces itself with the value it has read
+    // from the source row the item was made for
+    const char kRowFactory[] =
+        "(function (model, row, names) {\n"
+        "    var item = {};\n"
+        "    names.forEach(function (name) {\n"
+        "        Object.defineProperty(item, name, {\n"
+        "            configurable: true,\n"
+        "            enumerable: true,\n"
+        "            get: function () {\n"
+        "                var value = model.getSourceRoleValue(row, name);\n"
+        "                Object.defineProperty(item, name, { value: value, enumerable: true });\n"
+        "                return value;\n"
+        "            }\n"
+        "        });\n"
+        "    });\n"
+        "    return item;\n"
+        "})";
+
+    template <typename Func>
+    class Task : public QRunnable
+    {
+    public:
+        explicit Task(Func &&func) : m_func(std::move(func)) {}
+        void run() override { m_func(); }
+
+    private:
+        Func m_func;
+    };
+
+    template <typename Func>
+    void runInThreadPool(Func &&func)
+    {
+        QThreadPool::globalInstance()->start(new Task<std::decay_t<Func>>(std::forward<Func>(func)));
+    }
+
+    bool isNumber(int type)
+    {
+        switch (type) {
+        case QMetaType::Int:
+        case QMetaType::UInt:
+        case QMetaType::LongLong:
+        case QMetaType::ULongLong:
+        case QMetaType::Float:
+        case QMetaType::Double:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    template <typename T>
+    int compareValues(const T &left, const T &right)
+    {
+        return left < right ? -1 : (right < left ? 1 : 0);
+    }
+
+    // texts compare by the collator, the same way sortkeys::collate orders the typed keys
+    int compareSortKeys(const QVariant &left, const QVariant &right, const QCollator &collator)
+    {
+        const int leftType = left.userType();
+        const int rightType = right.userType();
+        if (leftType == QMetaType::ULongLong && rightType == QMetaType::ULongLong)
+            return compareValues(left.toULongLong(), right.toULongLong());
+        if (isNumber(leftType) && isNumber(rightType)) {
+            if (leftType == QMetaType::Double || leftType == QMetaType::Float
+                || rightType == QMetaType::Double || rightType == QMetaType::Float)
+                return compareValues(left.toDouble(), right.toDouble());
+            return compareValues(left.toLongLong(), right.toLongLong());
+        }
+        if (leftType == QMetaType::QDateTime && rightType == QMetaType::QDateTime)
+            return compareValues(left.toDateTime(), right.toDateTime());
+        return collator.compare(left.toString(), right.toString());
+    }
+
+    // sorts chunks of a large range in parallel and merges them
+    template <typename Less>
+    void parallelSort(std::vector<int> &items, Less less)
+    {
+        const size_t threads = std::max(1u, std::thread::hardware_concurrency());
+        const size_t chunks = std::min(threads, items.size() / kParallelSortChunk);
+        if (chunks < 2) {
+            std::sort(items.begin(), items.end(), less);
+            return;
+        }
+
+        std::vector<size_t> bounds;
+        for (size_t i = 0; i <= chunks; ++i)
+            bounds.push_back(items.size() * i / chunks);
+
+        std::vector<std::future<void>> parts;
+        for (size_t i = 0; i < chunks; ++i) {
+            parts.push_back(std::async(std::launch::async, [&items, &bounds, &less, i]() {
+                std::sort(items.begin() + bounds[i], items.begin() + bounds[i + 1], less);
+            }));
+        }
+        for (auto &part : parts)
+            part.get();
+
+        for (size_t width = 1; width < chunks; width *= 2) {
+            for (size_t i = 0; i + width < chunks; i += 2 * width) {
+                std::inplace_merge(items.begin() + bounds[i], items.begin() + bounds[i + width],
+                                   items.begin() + bounds[std::min(i + 2 * width, chunks)], less);
+            }
+        }
+    }
+
+    bool isLiteral(const QString &pattern, const char *specialChars)
+    {
+        for (const QChar c : pattern) {
+            if (c.unicode() < 0x80 && strchr(specialChars, c.toLatin1()))
+                return false;
+        }
+        return true;
+    }
+
+    // QRegExp wildcard syntax as an unanchored regular expression
+    QString wildcardToRegularExpression(const QString &pattern)
+    {
+        QString rx;
+        rx.reserve(pattern.size() * 2);
+        for (int i = 0; i < pattern.size(); ++i) {
+            const QChar c = pattern.at(i);
+            if (c == QLatin1Char('*')) {
+                rx += QLatin1String(".*");
+            } else if (c == QLatin1Char('?')) {
+                rx += QLatin1Char('.');
+            } else if (c == QLatin1Char('[')) {
+                const int end = pattern.indexOf(QLatin1Char(']'), i + 1);
+                if (end < 0) {
+                    rx += QLatin1String("\\[");
+                } else {
+                    rx += pattern.midRef(i, end - i + 1);
+                    i = end;
+                }
+            } else {
+                rx += QRegularExpression::escape(QString(c));
+            }
+        }
+        return rx;
+    }
+}
+
+struct SortFilterProxyModel::AsyncState
+{
+    QMutex mutex;
+    SortFilterProxyModel *owner = nullptr;
+    // a worker gives up as soon as a newer request has been made
+    std::atomic<int> filterGeneration{0};
+    std::atomic<int> sortGeneration{0};
+};
+
+SortFilterProxyModel::SortFilterProxyModel(QObject *parent)
+    : QSortFilterProxyModel(parent)
+    , m_complete(false)
+    , m_acceptAll(true)
+    , m_literalFilter(false)
+    , m_filterSyntax(RegExp)
+    , m_filterCaseSensitivity(Qt::CaseSensitive)
+    , m_filterBase(nullptr)
+    , m_filterPass(false)
+    , m_asynchronous(false)
+    , m_sourceVersion(0)
+    , m_async(std::make_shared<AsyncState>())
+    , m_asyncAccepted(nullptr)
+    , m_asyncFilterPending(false)
+    , m_asyncSortStale(false)
+    , m_sortKeysValid(false)
+    , m_hasSortKeys(false)
+    , m_sortKeysRole(-1)
+    , m_sortKeysCaseSensitivity(Qt::CaseSensitive)
+    , m_sortRanksRole(-1)
+    , m_sortOrder(Qt::AscendingOrder)
+    , m_sortPass(false)
 {
     connect(this, &QAbstractItemModel::rowsInserted, this, &SortFilterProxyModel::countChanged);
     connect(this, &QAbstractItemModel::rowsRemoved, this, &SortFilterProxyModel::countChanged);
     connect(this, &QAbstractItemModel::modelReset, this, &SortFilterProxyModel::countChanged);
     connect(this, &QAbstractItemModel::layoutChanged, this, &SortFilterProxyModel::countChanged);
+    connect(this, &QAbstractProxyModel::sourceModelChanged, this, &SortFilterProxyModel::onSourceModelChanged);
+    m_async->owner = this;
+}
+
+SortFilterProxyModel::~SortFilterProxyModel()
+{
+    QMutexLocker lock(&m_async->mutex);
+    m_async->owner = nullptr;
+    ++m_async->filterGeneration;
+    ++m_async->sortGeneration;
 }
 
 int SortFilterProxyModel::count() const
@@ -34,6 +236,9 @@ QObject *SortFilterProxyModel::source() const
 
 void SortFilterProxyModel::setSource(QObject *source)
 {
+    // a repeated notification of the same model must not reset the proxy
+    if (source == sourceModel())
+        return;
     setSourceModel(qobject_cast<QAbstractItemModel *>(source));
 }
 
@@ -47,13 +252,33 @@ void SortFilterProxyModel::setSortRole(const QByteArray &role)
     if (m_sortRole != role) {
         m_sortRole = role;
         if (m_complete)
-            QSortFilterProxyModel::setSortRole(roleKey(role));
+            updateSort();
     }
 }
 
+void SortFilterProxyModel::updateSort()
+{
+    // large sources are not sorted on the GUI thread, not even for the first time
+    if (m_sortRole.isEmpty())
+        return;
+    if (isAsync())
+        startAsyncSort();
+    else
+        QSortFilterProxyModel::setSortRole(roleKey(m_sortRole));
+}
+
 void SortFilterProxyModel::setSortOrder(Qt::SortOrder order)
 {
-    QSortFilterProxyModel::sort(0, order);
+    m_sortOrder = order;
+    if (!isAsync()) {
+        QSortFilterProxyModel::sort(0, order);
+        return;
+    }
+    // ranks are ascending, the other direction is a cheap re-sort with them
+    if (!m_sortRanks.empty() && m_sortRanksRole == roleKey(m_sortRole))
+        applySortRanks();
+    else
+        startAsyncSort();
 }
 
 QByteArray SortFilterProxyModel::filterRole() const
@@ -65,41 +290,438 @@ void SortFilterProxyModel::setFilterRole(const QByteArray &role)
 {
     if (m_filterRole != role) {
         m_filterRole = role;
-        if (m_complete)
-            QSortFilterProxyModel::setFilterRole(roleKey(role));
+        updateFilterRoles();
+    }
+}
+
+QStringList SortFilterProxyModel::filterRoles() const
+{
+    return m_filterRoles;
+}
+
+void SortFilterProxyModel::setFilterRoles(const QStringList &roles)
+{
+    if (m_filterRoles != roles) {
+        m_filterRoles = roles;
+        updateFilterRoles();
     }
 }
 
 QString SortFilterProxyModel::filterString() const
 {
-    return filterRegExp().pattern();
+    return m_filterPattern;
 }
 
 void SortFilterProxyModel::setFilterString(const QString &filter)
 {
-    setFilterRegExp(QRegExp(filter, filterCaseSensitivity(), static_cast<QRegExp::PatternSyntax>(filterSyntax())));
+    updateFilter(filter, filterSyntax(), filterCaseSensitivity());
 }
 
 SortFilterProxyModel::FilterSyntax SortFilterProxyModel::filterSyntax() const
 {
-    return static_cast<FilterSyntax>(filterRegExp().patternSyntax());
+    return m_filterSyntax;
 }
 
 void SortFilterProxyModel::setFilterSyntax(SortFilterProxyModel::FilterSyntax syntax)
 {
-    setFilterRegExp(QRegExp(filterString(), filterCaseSensitivity(), static_cast<QRegExp::PatternSyntax>(syntax)));
+    updateFilter(filterString(), syntax, filterCaseSensitivity());
+}
+
+Qt::CaseSensitivity SortFilterProxyModel::filterCaseSensitivity() const
+{
+    return m_filterCaseSensitivity;
+}
+
+void SortFilterProxyModel::setFilterCaseSensitivity(Qt::CaseSensitivity cs)
+{
+    updateFilter(filterString(), filterSyntax(), cs);
+}
+
+bool SortFilterProxyModel::asynchronous() const
+{
+    return m_asynchronous;
+}
+
+void SortFilterProxyModel::setAsynchronous(bool value)
+{
+    m_asynchronous = value;
 }
 
-QVariantMap SortFilterProxyModel::get(int idx) const
+void SortFilterProxyModel::updateFilter(const QString &pattern, FilterSyntax syntax, Qt::CaseSensitivity cs)
 {
-	QVariantMap map;
+    // filterRegExp() is set only when the rows are re-filtered, it may lag behind in the asynchronous mode
+    m_filterPattern = pattern;
+    m_filterSyntax = syntax;
+    m_filterCaseSensitivity = cs;
+
+    // matchers have to be ready before the regexp setter re-filters the rows
+    QString literal = pattern;
+    QString expression;
+    switch (syntax) {
+    case FixedString:
+        m_literalFilter = true;
+        break;
+    case Wildcard:
+        if (pattern.count(QLatin1Char('*')) == pattern.size()) {
+            literal.clear();
+            m_literalFilter = true;
+        } else {
+            m_literalFilter = isLiteral(pattern, "*?[]");
+            expression = wildcardToRegularExpression(pattern);
+        }
+        break;
+    default:
+        m_literalFilter = isLiteral(pattern, "\\^$.|?*+()[]{}");
+        expression = pattern;
+        break;
+    }
+
+    m_acceptAll = pattern.isEmpty() || (m_literalFilter && literal.isEmpty());
+    if (m_literalFilter) {
+        m_literalMatcher = QStringMatcher(literal, cs);
+        m_filterExpression = QRegularExpression();
+    } else {
+        m_filterExpression = QRegularExpression(expression,
+            cs == Qt::CaseInsensitive ? QRegularExpression::CaseInsensitiveOption : QRegularExpression::NoPatternOption);
+        m_filterExpression.optimize();
+    }
+
+    if (!m_acceptAll && isAsync()) {
+        startAsyncFilter();
+        return;
+    }
+    // cancels the filtering in progress, if any
+    ++m_async->filterGeneration;
+    m_asyncFilterPending = false;
+
+    // any key containing the new literal contains every literal it contains itself,
+    // so the closest of them gives the rows which are worth testing
+    m_filterPass = m_literalFilter && !m_acceptAll && sourceModel() != nullptr;
+    m_filterBase = nullptr;
+    if (m_filterPass) {
+        for (const auto &result : m_filterHistory) {
+            if (result.caseSensitivity == cs && literal.contains(result.literal, cs)
+                && (!m_filterBase || result.literal.size() > m_filterBase->literal.size()))
+                m_filterBase = &result;
+        }
+        FilterResult current;
+        current.literal = literal;
+        current.caseSensitivity = cs;
+        current.accepted.assign(sourceModel()->rowCount(), kNotTested);
+        m_filterHistory.push_back(std::move(current));
+    }
+
+    setFilterRegExp(QRegExp(pattern, cs, static_cast<QRegExp::PatternSyntax>(syntax)));
+
+    if (m_filterPass)
+        trimFilterHistory();
+    m_filterPass = false;
+    m_filterBase = nullptr;
+}
+
+void SortFilterProxyModel::trimFilterHistory()
+{
+    const auto &current = m_filterHistory.back();
+    for (auto it = m_filterHistory.begin(); it + 1 != m_filterHistory.end();) {
+        if (it->literal == current.literal && it->caseSensitivity == current.caseSensitivity)
+            it = m_filterHistory.erase(it);
+        else
+            ++it;
+    }
+    while (m_filterHistory.size() > kMaxFilterHistory)
+        m_filterHistory.pop_front();
+}
+
+bool SortFilterProxyModel::isAsync() const
+{
+    QAbstractItemModel *model = sourceModel();
+    return m_asynchronous && m_complete && model && model->rowCount() >= kAsyncMinRows;
+}
+
+void SortFilterProxyModel::startAsyncFilter()
+{
+    const int generation = ++m_async->filterGeneration;
+    const quint64 sourceVersion = m_sourceVersion;
+
+    QAbstractItemModel *model = sourceModel();
+    const int rows = model->rowCount();
+
+    // like the synchronous pass, a literal re-tests only the rows accepted by the closest earlier one
+    // and takes the rows of a repeated one as they are
+    const FilterResult *base = nullptr;
+    if (m_literalFilter) {
+        const QString literal = m_literalMatcher.pattern();
+        for (const auto &result : m_filterHistory) {
+            if (result.caseSensitivity == m_filterCaseSensitivity && literal.contains(result.literal, m_filterCaseSensitivity)
+                && result.accepted.size() == static_cast<size_t>(rows)
+                && (!base || result.literal.size() > base->literal.size()))
+                base = &result;
+        }
+    }
+    const bool repeated = base && base->literal.size() == m_literalMatcher.pattern().size();
+
+    auto accepted = std::make_shared<std::vector<char>>(rows, 0);
+    auto candidates = std::make_shared<std::vector<int>>();
+    for (int row = 0; row < rows; ++row) {
+        const signed char known = base ? base->accepted[row] : kNotTested;
+        if (known == 1 && repeated)
+            (*accepted)[row] = 1;
+        else if (known != 0)
+            candidates->push_back(row);
+    }
+    if (candidates->empty()) {
+        applyAsyncFilter(generation, sourceVersion, accepted);
+        return;
+    }
+
+    // a model can be read on its own thread only, so the texts are taken here and the worker
+    // gets plain strings; the list models give shared copies of the strings their rows keep,
+    // the other sources are read through data()
+    auto source = dynamic_cast<const SortKeySource *>(model);
+    auto keys = std::make_shared<std::vector<std::vector<QString>>>(m_filterRoleIds.size());
+    for (int i = 0; i < m_filterRoleIds.size(); ++i) {
+        const int role = m_filterRoleIds[i];
+        auto &texts = (*keys)[i];
+        if (source && source->filterTexts(role, *candidates, texts) && texts.size() == candidates->size())
+            continue;
+        texts.clear();
+        texts.reserve(candidates->size());
+        for (int row : *candidates)
+            texts.push_back(model->data(model->index(row, 0), role).toString());
+    }
+    m_asyncFilterPending = true;
+    m_asyncFilterChanges.clear();
+
+    runInThreadPool([state = m_async, generation, sourceVersion, keys, candidates, accepted,
+                     literalFilter = m_literalFilter, matcher = m_literalMatcher, expression = m_filterExpression]() {
+        for (size_t i = 0; i < candidates->size(); ++i) {
+            if ((i & 0xff) == 0 && state->filterGeneration != generation)
+                return;
+            for (const auto &texts : *keys) {
+                const QString &key = texts[i];
+                if (literalFilter ? matcher.indexIn(key) >= 0 : expression.match(key).hasMatch()) {
+                    (*accepted)[(*candidates)[i]] = 1;
+                    break;
+                }
+            }
+        }
+
+        QMutexLocker lock(&state->mutex);
+        if (SortFilterProxyModel *owner = state->owner) {
+            QMetaObject::invokeMethod(owner, [owner, generation, sourceVersion, accepted]() {
+                owner->applyAsyncFilter(generation, sourceVersion, accepted);
+            }, Qt::QueuedConnection);
+        }
+    });
+}
+
+void SortFilterProxyModel::applyAsyncFilter(int generation, quint64 sourceVersion, std::shared_ptr<std::vector<char>> accepted)
+{
+    if (generation != m_async->filterGeneration)
+        return;
+    m_asyncFilterPending = false;
+    if (sourceVersion != m_sourceVersion) {
+        startAsyncFilter();
+        return;
+    }
+
+    // rows changed while the worker ran are tested again here, the others keep its result
+    for (const auto &range : m_asyncFilterChanges) {
+        const int end = std::min(range.second + 1, static_cast<int>(accepted->size()));
+        for (int row = range.first; row < end; ++row)
+            (*accepted)[row] = testRow(row, QModelIndex()) ? 1 : 0;
+    }
+    m_asyncFilterChanges.clear();
+
+    m_asyncAccepted = accepted.get();
+    setFilterRegExp(QRegExp(m_filterPattern, m_filterCaseSensitivity, static_cast<QRegExp::PatternSyntax>(m_filterSyntax)));
+    m_asyncAccepted = nullptr;
+
+    if (m_literalFilter) {
+        FilterResult result;
+        result.literal = m_literalMatcher.pattern();
+        result.caseSensitivity = m_filterCaseSensitivity;
+        result.accepted.assign(accepted->begin(), accepted->end());
+        m_filterHistory.push_back(std::move(result));
+        trimFilterHistory();
+    }
+}
+
+void SortFilterProxyModel::startAsyncSort()
+{
+    const int generation = ++m_async->sortGeneration;
+    const quint64 sourceVersion = m_sourceVersion;
+    m_asyncSortStale = false;
+    const int role = roleKey(m_sortRole);
+    const Qt::CaseSensitivity cs = sortCaseSensitivity();
+
+    // typed keys are copied as they are, the texts of collated keys are collated by the worker,
+    // other sources give their role values; the source itself can be read on its own thread only
+    auto typedKeys = std::make_shared<std::vector<quint64>>();
+    auto texts = std::make_shared<std::vector<QString>>();
+    auto keys = std::make_shared<std::vector<QVariant>>();
+    auto source = dynamic_cast<const SortKeySource *>(sourceModel());
+    const bool cached = m_sortKeysValid && m_sortKeysRole == role && m_sortKeysCaseSensitivity == cs;
+    const bool collate = !cached && source && source->sortTexts(role, *texts);
+    if (!collate) {
+        if (const std::vector<quint64> *sourceKeys = cachedSortKeys(role)) {
+            *typedKeys = *sourceKeys;
+        } else {
+            QAbstractItemModel *model = sourceModel();
+            const int rows = model->rowCount();
+            keys->reserve(rows);
+            for (int row = 0; row < rows; ++row)
+                keys->push_back(model->data(model->index(row, 0), role));
+        }
+    }
+
+    runInThreadPool([state = m_async, generation, sourceVersion, role, keys, typedKeys, texts, collate,
+                     cs, locale = QLocale()]() {
+        if (state->sortGeneration != generation)
+            return;
+
+        if (collate)
+            *typedKeys = sortkeys::collate(*texts, cs);
+
+        std::vector<int> order(collate ? texts->size() : std::max(keys->size(), typedKeys->size()));
+        std::iota(order.begin(), order.end(), 0);
+        if (collate || !typedKeys->empty()) {
+            parallelSort(order, [&typedKeys](int left, int right) {
+                const quint64 leftKey = (*typedKeys)[left];
+                const quint64 rightKey = (*typedKeys)[right];
+                return leftKey != rightKey ? leftKey < rightKey : left < right;
+            });
+        } else {
+            QCollator collator(locale);
+            collator.setCaseSensitivity(cs);
+            // set up here, the chunks sorted in parallel only read it
+            collator.compare(QString(), QString());
+            parallelSort(order, [&keys, &collator](int left, int right) {
+                const int result = compareSortKeys((*keys)[left], (*keys)[right], collator);
+                return result != 0 ? result < 0 : left < right;
+            });
+        }
+
+        auto ranks = std::make_shared<std::vector<int>>(order.size());
+        for (size_t i = 0; i < order.size(); ++i)
+            (*ranks)[order[i]] = static_cast<int>(i);
+        // keys collated here are kept by the model for the rows it re-sorts later
+        std::shared_ptr<std::vector<quint64>> collatedKeys;
+        if (collate)
+            collatedKeys = typedKeys;
+
+        QMutexLocker lock(&state->mutex);
+        if (state->sortGeneration != generation)
+            return;
+        if (SortFilterProxyModel *owner = state->owner) {
+            QMetaObject::invokeMethod(owner, [owner, generation, sourceVersion, role, cs, ranks, collatedKeys]() {
+                owner->applyAsyncSort(generation, sourceVersion, role, cs, ranks, collatedKeys);
+            }, Qt::QueuedConnection);
+        }
+    });
+}
+
+void SortFilterProxyModel::applyAsyncSort(int generation, quint64 sourceVersion, int role, Qt::CaseSensitivity cs,
+                                          std::shared_ptr<std::vector<int>> ranks, std::shared_ptr<std::vector<quint64>> keys)
+{
+    if (generation != m_async->sortGeneration)
+        return;
+    if (sourceVersion != m_sourceVersion || m_asyncSortStale) {
+        startAsyncSort();
+        return;
+    }
+    if (keys) {
+        m_sortKeys = std::move(*keys);
+        m_sortKeysValid = true;
+        m_hasSortKeys = true;
+        m_sortKeysRole = role;
+        m_sortKeysCaseSensitivity = cs;
+    }
+    m_sortRanks = std::move(*ranks);
+    m_sortRanksRole = role;
+    applySortRanks();
+}
+
+void SortFilterProxyModel::applySortRanks()
+{
+    m_sortPass = true;
+    if (QSortFilterProxyModel::sortRole() != m_sortRanksRole)
+        QSortFilterProxyModel::setSortRole(m_sortRanksRole);
+    QSortFilterProxyModel::sort(0, m_sortOrder);
+    m_sortPass = false;
+}
+
+const std::vector<quint64> *SortFilterProxyModel::cachedSortKeys(int role) const
+{
+    const Qt::CaseSensitivity cs = sortCaseSensitivity();
+    if (!m_sortKeysValid || m_sortKeysRole != role || m_sortKeysCaseSensitivity != cs) {
+        m_sortKeys.clear();
+        m_sortKeysValid = true;
+        m_sortKeysRole = role;
+        m_sortKeysCaseSensitivity = cs;
+
+        QAbstractItemModel *model = sourceModel();
+        auto source = dynamic_cast<const SortKeySource *>(model);
+        m_hasSortKeys = source && source->sortKeys(role, cs, m_sortKeys)
+            && m_sortKeys.size() == static_cast<size_t>(model->rowCount());
+    }
+    return m_hasSortKeys ? &m_sortKeys : nullptr;
+}
+
+const QCollator &SortFilterProxyModel::sortCollator() const
+{
+    // follows the locale and the case sensitivity like the keys collated by the sources
+    if (m_sortCollator.locale() != QLocale() || m_sortCollator.caseSensitivity() != sortCaseSensitivity()) {
+        m_sortCollator = QCollator(QLocale());
+        m_sortCollator.setCaseSensitivity(sortCaseSensitivity());
+    }
+    return m_sortCollator;
+}
+
+void SortFilterProxyModel::clearFilterHistory()
+{
+    m_filterHistory.clear();
+    m_filterBase = nullptr;
+    m_filterPass = false;
+}
+
+bool SortFilterProxyModel::acceptsKey(const QString &key) const
+{
+    if (m_literalFilter)
+        return m_literalMatcher.indexIn(key) >= 0;
+    return m_filterExpression.match(key).hasMatch();
+}
+
+QJSValue SortFilterProxyModel::get(int idx) const
+{
+    QJSEngine *engine = qjsEngine(this);
+    if (!engine || idx < 0 || idx >= count())
+        return QJSValue();
+
+    if (m_rowFactory.isUndefined()) {
+        m_rowModel = engine->newQObject(const_cast<SortFilterProxyModel *>(this));
+        m_rowFactory = engine->evaluate(QString::fromLatin1(kRowFactory));
+    }
+    if (m_rowRoleNames.isUndefined()) {
+        m_rowRoleNames = engine->newArray(static_cast<uint>(m_roleIds.size()));
+        quint32 i = 0;
+        for (auto it = m_roleIds.cbegin(); it != m_roleIds.cend(); ++it)
+            m_rowRoleNames.setProperty(i++, QString::fromUtf8(it.key()));
+    }
+    // a re-sort or re-filter before a role is read must not switch the item to another row
+    const QPersistentModelIndex sourceIndex(mapToSource(index(idx, 0)));
+    return m_rowFactory.call({m_rowModel, engine->toScriptValue(QVariant::fromValue(sourceIndex)), m_rowRoleNames});
+}
+
+QVariantMap SortFilterProxyModel::getRoles(int idx, const QStringList &names) const
+{
+    QVariantMap map;
     if (idx >= 0 && idx < count()) {
-        QHash<int, QByteArray> roles = roleNames();
-        QHashIterator<int, QByteArray> it(roles);
-        while (it.hasNext()) {
-            it.next();
-			auto roleName = QString::fromUtf8(it.value());
-			map[roleName] = data(index(idx, 0), it.key());
+        const QModelIndex proxyIndex = index(idx, 0);
+        for (const auto &name : names) {
+            const int role = roleKey(name.toUtf8());
+            if (role >= 0)
+                map[name] = data(proxyIndex, role);
         }
     }
     return map;
@@ -107,16 +729,19 @@ QVariantMap SortFilterProxyModel::get(int idx) const
 
 QVariant SortFilterProxyModel::getRoleValue(int idx, QByteArray roleName) const
 {
-    QHash<int, QByteArray> roles = roleNames();
-    QHashIterator<int, QByteArray> it(roles);
-    while (it.hasNext()) {
-        it.next();
-        if (roleName == it.value())
-        {
-            return data(index(idx, 0), it.key());
-        }
-    }
-    return QVariant();
+    const int role = roleKey(roleName);
+    if (role < 0)
+        return QVariant();
+    return data(index(idx, 0), role);
+}
+
+QVariant SortFilterProxyModel::getSourceRoleValue(const QVariant &sourceIndex, QByteArray roleName) const
+{
+    const int role = roleKey(roleName);
+    const QPersistentModelIndex index = sourceIndex.value<QPersistentModelIndex>();
+    if (role < 0 || !index.isValid() || index.model() != sourceModel())
+        return QVariant();
+    return index.data(role);
 }
 
 void SortFilterProxyModel::classBegin()
@@ -126,22 +751,199 @@ void SortFilterProxyModel::classBegin()
 void SortFilterProxyModel::componentComplete()
 {
     m_complete = true;
-    if (!m_sortRole.isEmpty())
-        QSortFilterProxyModel::setSortRole(roleKey(m_sortRole));
-    if (!m_filterRole.isEmpty())
-        QSortFilterProxyModel::setFilterRole(roleKey(m_filterRole));
+    updateSort();
+    updateFilterRoles();
+}
+
+bool SortFilterProxyModel::sortKeys(int role, Qt::CaseSensitivity cs, std::vector<quint64> &keys) const
+{
+    auto source = dynamic_cast<const SortKeySource *>(sourceModel());
+    std::vector<quint64> sourceKeys;
+    if (!source || !source->sortKeys(role, cs, sourceKeys))
+        return false;
+
+    const int rows = rowCount();
+    keys.resize(rows);
+    for (int row = 0; row < rows; ++row) {
+        const int sourceRow = mapToSource(index(row, 0)).row();
+        if (sourceRow < 0 || sourceRow >= static_cast<int>(sourceKeys.size()))
+            return false;
+        keys[row] = sourceKeys[sourceRow];
+    }
+    return true;
+}
+
+bool SortFilterProxyModel::updateSortKeys(int role, int first, int last, std::vector<quint64> &keys) const
+{
+    auto source = dynamic_cast<const SortKeySource *>(sourceModel());
+    if (!source || last >= static_cast<int>(keys.size()))
+        return false;
+
+    // the source patches a key array of its own rows, only the span of the changed ones is allocated
+    std::vector<int> sourceRows;
+    for (int row = first; row <= last; ++row)
+        sourceRows.push_back(mapToSource(index(row, 0)).row());
+    const auto bounds = std::minmax_element(sourceRows.begin(), sourceRows.end());
+    if (sourceRows.empty() || *bounds.first < 0)
+        return false;
+
+    std::vector<quint64> sourceKeys(*bounds.second + 1);
+    if (!source->updateSortKeys(role, *bounds.first, *bounds.second, sourceKeys))
+        return false;
+    for (int row = first; row <= last; ++row)
+        keys[row] = sourceKeys[sourceRows[row - first]];
+    return true;
+}
+
+bool SortFilterProxyModel::sortTexts(int role, std::vector<QString> &texts) const
+{
+    auto source = dynamic_cast<const SortKeySource *>(sourceModel());
+    std::vector<QString> sourceTexts;
+    if (!source || !source->sortTexts(role, sourceTexts))
+        return false;
+
+    const int rows = rowCount();
+    texts.clear();
+    texts.reserve(rows);
+    for (int row = 0; row < rows; ++row) {
+        const int sourceRow = mapToSource(index(row, 0)).row();
+        if (sourceRow < 0 || sourceRow >= static_cast<int>(sourceTexts.size()))
+            return false;
+        texts.push_back(std::move(sourceTexts[sourceRow]));
+    }
+    return true;
+}
+
+bool SortFilterProxyModel::filterTexts(int role, const std::vector<int> &rows, std::vector<QString> &texts) const
+{
+    auto source = dynamic_cast<const SortKeySource *>(sourceModel());
+    std::vector<int> sourceRows;
+    sourceRows.reserve(rows.size());
+    for (int row : rows)
+        sourceRows.push_back(mapToSource(index(row, 0)).row());
+    if (std::find(sourceRows.begin(), sourceRows.end(), -1) != sourceRows.end())
+        return false;
+    return source && source->filterTexts(role, sourceRows, texts);
 }
 
 int SortFilterProxyModel::roleKey(const QByteArray &role) const
 {
-    QHash<int, QByteArray> roles = roleNames();
-    QHashIterator<int, QByteArray> it(roles);
-    while (it.hasNext()) {
-        it.next();
-        if (it.value() == role)
-            return it.key();
+    return m_roleIds.value(role, -1);
+}
+
+void SortFilterProxyModel::onSourceModelChanged()
+{
+    for (const auto &connection : m_sourceConnections)
+        disconnect(connection);
+    m_sourceConnections.clear();
+
+    onSourceChanged();
+
+    // row numbers of the stored filter results and sort ranks are not valid after the rows change,
+    // changed data invalidates only what depends on the changed rows and roles
+    if (QAbstractItemModel *model = sourceModel()) {
+        m_sourceConnections = {
+            connect(model, &QAbstractItemModel::rowsInserted, this, &SortFilterProxyModel::onSourceChanged),
+            connect(model, &QAbstractItemModel::rowsRemoved, this, &SortFilterProxyModel::onSourceChanged),
+            connect(model, &QAbstractItemModel::rowsMoved, this, &SortFilterProxyModel::onSourceChanged),
+            connect(model, &QAbstractItemModel::modelReset, this, &SortFilterProxyModel::onSourceChanged),
+            connect(model, &QAbstractItemModel::layoutChanged, this, &SortFilterProxyModel::onSourceChanged),
+            connect(model, &QAbstractItemModel::dataChanged, this, &SortFilterProxyModel::onSourceDataChanged)
+        };
+    }
+    resolveRoles();
+}
+
+void SortFilterProxyModel::onSourceChanged()
+{
+    ++m_sourceVersion;
+    m_asyncFilterChanges.clear();
+    clearFilterHistory();
+    m_sortRanks.clear();
+    // connected before the base class handlers, so a re-sort of the changed rows reads fresh keys
+    m_sortKeysValid = false;
+}
+
+void SortFilterProxyModel::onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles)
+{
+    if (topLeft.parent().isValid()) {
+        onSourceChanged();
+        return;
+    }
+
+    const int first = topLeft.row();
+    const int last = bottomRight.row();
+    auto changed = [&roles](int role) { return roles.isEmpty() || roles.contains(role); };
+
+    // the other rows keep their results, the changed ones are tested again when they are needed
+    bool filterChanged = false;
+    for (int role : m_filterRoleIds)
+        filterChanged = filterChanged || changed(role);
+    if (filterChanged) {
+        for (auto &result : m_filterHistory) {
+            const int end = std::min(last + 1, static_cast<int>(result.accepted.size()));
+            for (int row = first; row < end; ++row)
+                result.accepted[row] = kNotTested;
+        }
+    }
+
+    // the base class re-sorts the changed rows after this handler, with the patched keys
+    if (m_sortKeysValid && m_hasSortKeys && changed(m_sortKeysRole)) {
+        auto source = dynamic_cast<const SortKeySource *>(sourceModel());
+        if (!source || last >= static_cast<int>(m_sortKeys.size())
+            || !source->updateSortKeys(m_sortKeysRole, first, last, m_sortKeys))
+            m_sortKeysValid = false;
+    }
+    if (!m_sortRanks.empty() && changed(m_sortRanksRole))
+        m_sortRanks.clear();
+
+    // a filter computed in the background is patched for these rows when it arrives,
+    // the ranks of a sort are not, it is computed again
+    if (filterChanged && m_asyncFilterPending)
+        m_asyncFilterChanges.emplace_back(first, last);
+    if (changed(roleKey(m_sortRole)))
+        m_asyncSortStale = true;
+}
+
+void SortFilterProxyModel::resolveRoles()
+{
+    m_roleIds.clear();
+    m_rowRoleNames = QJSValue();
+    const QHash<int, QByteArray> roles = roleNames();
+    for (auto it = roles.cbegin(); it != roles.cend(); ++it)
+        m_roleIds.insert(it.value(), it.key());
+
+    if (m_complete)
+        updateSort();
+    updateFilterRoles();
+}
+
+void SortFilterProxyModel::updateFilterRoles()
+{
+    clearFilterHistory();
+    // the rows are re-filtered below, a pending result read the old roles
+    ++m_async->filterGeneration;
+    m_asyncFilterPending = false;
+    m_filterRoleIds.clear();
+    if (!m_filterRoles.isEmpty()) {
+        for (const auto &role : m_filterRoles) {
+            const int id = roleKey(role.toUtf8());
+            if (id >= 0)
+                m_filterRoleIds.push_back(id);
+        }
+    } else if (!m_filterRole.isEmpty()) {
+        // unknown role is kept, it filters as an empty string like before
+        m_filterRoleIds.push_back(roleKey(m_filterRole));
+    } else {
+        for (auto it = m_roleIds.cbegin(); it != m_roleIds.cend(); ++it)
+            m_filterRoleIds.push_back(it.value());
+    }
+
+    if (m_complete) {
+        if (!m_filterRole.isEmpty())
+            QSortFilterProxyModel::setFilterRole(roleKey(m_filterRole));
+        invalidateFilter();
     }
-    return -1;
 }
 
 QHash<int, QByteArray> SortFilterProxyModel::roleNames() const
@@ -153,25 +955,58 @@ QHash<int, QByteArray> SortFilterProxyModel::roleNames() const
 
 bool SortFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const
 {
-    QRegExp rx = filterRegExp();
-    if (rx.isEmpty())
+    if (m_acceptAll)
         return true;
+    if (m_asyncAccepted && !sourceParent.isValid()
+        && sourceRow >= 0 && sourceRow < static_cast<int>(m_asyncAccepted->size()))
+        return (*m_asyncAccepted)[sourceRow] != 0;
+    if (!m_filterPass || sourceParent.isValid())
+        return testRow(sourceRow, sourceParent);
+
+    auto &current = m_filterHistory.back();
+    if (sourceRow < 0 || sourceRow >= static_cast<int>(current.accepted.size()))
+        return testRow(sourceRow, sourceParent);
+
+    signed char known = kNotTested;
+    if (m_filterBase && sourceRow < static_cast<int>(m_filterBase->accepted.size()))
+        known = m_filterBase->accepted[sourceRow];
+
+    bool accepted = false;
+    if (known == 0 || (known == 1 && m_filterBase->literal.size() == current.literal.size()))
+        accepted = known == 1;
+    else
+        accepted = testRow(sourceRow, sourceParent);
+    current.accepted[sourceRow] = accepted ? 1 : 0;
+    return accepted;
+}
+
+bool SortFilterProxyModel::testRow(int sourceRow, const QModelIndex &sourceParent) const
+{
     QAbstractItemModel *model = sourceModel();
-    if (filterRole().isEmpty()) {
-        QHash<int, QByteArray> roles = roleNames();
-        QHashIterator<int, QByteArray> it(roles);
-        while (it.hasNext()) {
-            it.next();
-            QModelIndex sourceIndex = model->index(sourceRow, 0, sourceParent);
-            QString key = model->data(sourceIndex, it.key()).toString();
-            if (key.contains(rx))
-                return true;
-        }
-        return false;
-    }
     QModelIndex sourceIndex = model->index(sourceRow, 0, sourceParent);
     if (!sourceIndex.isValid())
         return true;
-    QString key = model->data(sourceIndex, roleKey(filterRole())).toString();
-    return key.contains(rx);
+    for (int role : m_filterRoleIds) {
+        if (acceptsKey(model->data(sourceIndex, role).toString()))
+            return true;
+    }
+    return false;
+}
+
+bool SortFilterProxyModel::lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const
+{
+    const int size = static_cast<int>(m_sortRanks.size());
+    if (m_sortPass && sourceLeft.row() < size && sourceRight.row() < size
+        && !sourceLeft.parent().isValid() && !sourceRight.parent().isValid())
+        return m_sortRanks[sourceLeft.row()] < m_sortRanks[sourceRight.row()];
+
+    // rows re-sorted by the base model compare the same way as the ranks were built
+    const int role = QSortFilterProxyModel::sortRole();
+    if (const std::vector<quint64> *keys = cachedSortKeys(role)) {
+        const int rows = static_cast<int>(keys->size());
+        if (sourceLeft.row() < rows && sourceRight.row() < rows
+            && !sourceLeft.parent().isValid() && !sourceRight.parent().isValid())
+            return (*keys)[sourceLeft.row()] < (*keys)[sourceRight.row()];
+    }
+    return compareSortKeys(sourceLeft.data(role), sourceRight.data(role), sortCollator()) < 0;
 }
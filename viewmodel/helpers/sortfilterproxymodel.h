@@ -13,10 +13,18 @@
 // limitations under the License.
 #pragma once
 
+#include <QtCore/qcollator.h>
+#include <QtCore/qregularexpression.h>
 #include <QtCore/qsortfilterproxymodel.h>
+#include <QtCore/qstringmatcher.h>
+#include <QtQml/qjsvalue.h>
 #include <QtQml/qqmlparserstatus.h>
+#include "sort_keys.h"
+#include <deque>
+#include <memory>
+#include <vector>
 
-class SortFilterProxyModel : public QSortFilterProxyModel, public QQmlParserStatus
+class SortFilterProxyModel : public QSortFilterProxyModel, public QQmlParserStatus, public SortKeySource
 {
     Q_OBJECT
     Q_INTERFACES(QQmlParserStatus)
@@ -28,13 +36,17 @@ class SortFilterProxyModel : public QSortFilterProxyModel, public QQmlParserStat
     Q_PROPERTY(Qt::SortOrder sortOrder READ sortOrder WRITE setSortOrder)
 
     Q_PROPERTY(QByteArray filterRole READ filterRole WRITE setFilterRole)
+    Q_PROPERTY(QStringList filterRoles READ filterRoles WRITE setFilterRoles)
     Q_PROPERTY(QString filterString READ filterString WRITE setFilterString)
     Q_PROPERTY(FilterSyntax filterSyntax READ filterSyntax WRITE setFilterSyntax)
+    Q_PROPERTY(Qt::CaseSensitivity filterCaseSensitivity READ filterCaseSensitivity WRITE setFilterCaseSensitivity)
+    Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous)
 
     Q_ENUMS(FilterSyntax)
 
 public:
     explicit SortFilterProxyModel(QObject *parent = 0);
+    ~SortFilterProxyModel() override;
 
     QObject *source() const;
     void setSource(QObject *source);
@@ -47,6 +59,10 @@ public:
     QByteArray filterRole() const;
     void setFilterRole(const QByteArray &role);
 
+    // roles matched by the filter, take precedence over filterRole
+    QStringList filterRoles() const;
+    void setFilterRoles(const QStringList &roles);
+
     QString filterString() const;
     void setFilterString(const QString &filter);
 
@@ -59,13 +75,32 @@ public:
     FilterSyntax filterSyntax() const;
     void setFilterSyntax(FilterSyntax syntax);
 
+    // hide the base ones, the matchers have to be rebuilt for the new case sensitivity
+    Qt::CaseSensitivity filterCaseSensitivity() const;
+    void setFilterCaseSensitivity(Qt::CaseSensitivity cs);
+
+    // large sources are sorted and filtered on a worker thread,
+    // the result replaces the rows at once when it is ready
+    bool asynchronous() const;
+    void setAsynchronous(bool value);
+
     int count() const;
-    Q_INVOKABLE QVariantMap get(int index) const;
+    // an object with a property per role, every role is read on the first access only
+    Q_INVOKABLE QJSValue get(int index) const;
+    Q_INVOKABLE QVariantMap getRoles(int index, const QStringList &names) const;
     Q_INVOKABLE QVariant getRoleValue(int index, QByteArray roleName) const;
+    // value of the source row pinned by get(), empty once the row is removed
+    Q_INVOKABLE QVariant getSourceRoleValue(const QVariant &sourceIndex, QByteArray roleName) const;
 
     void classBegin();
     void componentComplete();
 
+    // keys of the source rows in the proxy order, so a proxy sorting this one uses them too
+    bool sortKeys(int role, Qt::CaseSensitivity cs, std::vector<quint64> &keys) const override;
+    bool updateSortKeys(int role, int first, int last, std::vector<quint64> &keys) const override;
+    bool sortTexts(int role, std::vector<QString> &texts) const override;
+    bool filterTexts(int role, const std::vector<int> &rows, std::vector<QString> &texts) const override;
+
 signals:
     void countChanged();
 
@@ -73,9 +108,92 @@ protected:
     int roleKey(const QByteArray &role) const;
     QHash<int, QByteArray> roleNames() const;
     bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const;
+    bool lessThan(const QModelIndex &sourceLeft, const QModelIndex &sourceRight) const;
 
 private:
+    // accepted state of the source rows for a literal filter, -1 if the row wasn't tested
+    struct FilterResult
+    {
+        QString literal;
+        Qt::CaseSensitivity caseSensitivity;
+        std::vector<signed char> accepted;
+    };
+
+    // shared with the workers, which outlive the model if it is destroyed before they finish
+    struct AsyncState;
+
+    void onSourceModelChanged();
+    void onSourceChanged();
+    void onSourceDataChanged(const QModelIndex &topLeft, const QModelIndex &bottomRight, const QVector<int> &roles);
+    void resolveRoles();
+    void updateFilterRoles();
+    void updateFilter(const QString &pattern, FilterSyntax syntax, Qt::CaseSensitivity cs);
+    void clearFilterHistory();
+    void trimFilterHistory();
+    void updateSort();
+    bool isAsync() const;
+    void startAsyncFilter();
+    void applyAsyncFilter(int generation, quint64 sourceVersion, std::shared_ptr<std::vector<char>> accepted);
+    void startAsyncSort();
+    void applyAsyncSort(int generation, quint64 sourceVersion, int role, Qt::CaseSensitivity cs,
+                        std::shared_ptr<std::vector<int>> ranks, std::shared_ptr<std::vector<quint64>> keys);
+    void applySortRanks();
+    const std::vector<quint64> *cachedSortKeys(int role) const;
+    const QCollator &sortCollator() const;
+    bool acceptsKey(const QString &key) const;
+    bool testRow(int sourceRow, const QModelIndex &sourceParent) const;
+
     bool m_complete;
     QByteArray m_sortRole;
     QByteArray m_filterRole;
+    QStringList m_filterRoles;
+    // role ids of the source model, resolved when the source or the roles change
+    QHash<QByteArray, int> m_roleIds;
+    QVector<int> m_filterRoleIds;
+    // filterRegExp() keeps the pattern for the getters, the rows are matched with these:
+    // patterns without special characters as plain substrings, others with QRegularExpression
+    QString m_filterPattern;
+    FilterSyntax m_filterSyntax;
+    Qt::CaseSensitivity m_filterCaseSensitivity;
+    bool m_acceptAll;
+    bool m_literalFilter;
+    QStringMatcher m_literalMatcher;
+    QRegularExpression m_filterExpression;
+    // results of the last literal filters, valid until the source or the filter roles change;
+    // a longer literal re-tests only the rows accepted by a shorter one, a repeated one re-tests nothing
+    mutable std::deque<FilterResult> m_filterHistory;
+    const FilterResult *m_filterBase;
+    bool m_filterPass;
+    QVector<QMetaObject::Connection> m_sourceConnections;
+    // script side of get(), created in the engine of the model on the first call
+    mutable QJSValue m_rowFactory;
+    mutable QJSValue m_rowModel;
+    mutable QJSValue m_rowRoleNames;
+
+    bool m_asynchronous;
+    // bumped when the rows of the source change, results computed for older rows are recomputed
+    quint64 m_sourceVersion;
+    std::shared_ptr<AsyncState> m_async;
+    const std::vector<char> *m_asyncAccepted;
+    // a filter is being computed in the background, the rows changed meanwhile are re-tested
+    // when its result arrives
+    bool m_asyncFilterPending;
+    std::vector<std::pair<int, int>> m_asyncFilterChanges;
+    // the sort role of some rows changed while the ranks were being computed
+    bool m_asyncSortStale;
+    // typed keys of the source rows for m_sortKeysRole, built on demand and dropped when rows
+    // are added, removed or moved; sources which are not a SortKeySource compare by data
+    mutable std::vector<quint64> m_sortKeys;
+    mutable bool m_sortKeysValid;
+    mutable bool m_hasSortKeys;
+    mutable int m_sortKeysRole;
+    mutable Qt::CaseSensitivity m_sortKeysCaseSensitivity;
+    // compares the texts of the sources without typed keys, in both the synchronous and the worker sort
+    mutable QCollator m_sortCollator;
+    // ascending position of every source row by m_sortRanksRole, used by lessThan only
+    // while the proxy re-sorts on its own request, the rows compare by keys or data otherwise
+    std::vector<int> m_sortRanks;
+    int m_sortRanksRole;
+    Qt::SortOrder m_sortOrder;
+    bool m_sortPass;
 };
@@ -20,21 +20,26 @@
 
 TokenBootstrapManager::TokenBootstrapManager()
     : _wallet_model(*AppModel::getInstance().getWallet())
+    , _transaction_store(AppModel::getInstance().getTransactionStore())
 {
     connect(
-        &_wallet_model,
+        &_transaction_store,
         SIGNAL(transactionsChanged(beam::wallet::ChangeAction,
-                        const std::vector<beam::wallet::TxDescription>&)),
+                        const SharedItems<beam::wallet::TxDescription>&)),
         SLOT(onTransactionsChanged(beam::wallet::ChangeAction,
-                        const std::vector<beam::wallet::TxDescription>&)));
-    _wallet_model.getAsync()->getTransactions();
+                        const SharedItems<beam::wallet::TxDescription>&)));
+    if (_transaction_store.isLoaded())
+    {
+        onTransactionsChanged(beam::wallet::ChangeAction::Reset,
+                              _transaction_store.getTransactions());
+    }
 }
 
 TokenBootstrapManager::~TokenBootstrapManager() {}
 
 void TokenBootstrapManager::onTransactionsChanged(
     beam::wallet::ChangeAction action,
-    const std::vector<beam::wallet::TxDescription>& items)
+    const SharedItems<beam::wallet::TxDescription>& items)
 {
     switch (action)
     {
@@ -42,7 +47,7 @@ void TokenBootstrapManager::onTransactionsChanged(
         _myTxIds.clear(); // no break
     case beam::wallet::ChangeAction::Added:
     case beam::wallet::ChangeAction::Updated:
-        for (const auto& item : items)
+        for (const auto& item : *items)
         {
             if (const auto& id = item.GetTxID(); id)
             {
@@ -51,7 +56,7 @@ void TokenBootstrapManager::onTransactionsChanged(
         }
         break;
     case beam::wallet::ChangeAction::Removed:
-        for (const auto& item : items)
+        for (const auto& item : *items)
         {
             if (const auto& id = item.GetTxID(); id)
             {
@@ -91,9 +96,11 @@ void TokenBootstrapManager::checkTokenForDuplicate(const QString& token)
     auto txIdValue = txId.value();
     _tokensInProgress[txIdValue] = token;
 
-    _myTxIds.empty()
-        ? _wallet_model.getAsync()->getTransactions()
-        : checkIsTxPreviousAccepted();
+    // otherwise the tokens are checked when the transactions are loaded
+    if (_transaction_store.isLoaded())
+    {
+        checkIsTxPreviousAccepted();
+    }
 }
 
 void TokenBootstrapManager::checkIsTxPreviousAccepted()
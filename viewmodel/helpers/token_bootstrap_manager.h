@@ -14,6 +14,7 @@
 #pragma once
 
 #include "model/wallet_model.h"
+#include "model/transaction_store.h"
 #include <map>
 #include <set>
 #include <QObject>
@@ -30,7 +31,7 @@ public:
 
 public slots:
     void onTransactionsChanged(beam::wallet::ChangeAction action,
-                    const std::vector<beam::wallet::TxDescription>& items);
+                    const SharedItems<beam::wallet::TxDescription>& items);
 
 signals:   
     void tokenPreviousAccepted(const QString& token);
@@ -41,6 +42,7 @@ private:
     void checkIsTxPreviousAccepted();
 
     WalletModel& _wallet_model;
+    TransactionStore& _transaction_store;
     std::map<beam::wallet::TxID, QString> _tokensInProgress;
     std::set<beam::wallet::TxID> _myTxIds;
 };
@@ -283,8 +283,13 @@ void SendSwapViewModel::setExpiresTime(const QDateTime& value)
     }
 }
 
-void SendSwapViewModel::onChangeCalculated(beam::Amount change)
+void SendSwapViewModel::onChangeCalculated(beam::Amount amount, beam::Amount change)
 {
+    // replies to the other screens or for an amount typed before are not for this one
+    if (amount != _sendAmountGrothes + _sendFeeGrothes)
+    {
+        return;
+    }
     _changeGrothes = change;
     emit enoughChanged();
     emit canSendChanged();
@@ -329,7 +334,7 @@ void SendSwapViewModel::recalcAvailable()
     {
     case Currency::CurrBeam:
         _changeGrothes = 0;
-        _walletModel.getAsync()->calcChange(_sendAmountGrothes + _sendFeeGrothes);
+        _walletModel.calcChange(_sendAmountGrothes + _sendFeeGrothes);
         return;
     default:
         // TODO:SWAP implement for all currencies
@@ -109,7 +109,7 @@ signals:
     void isReceiveFeeOKChanged();
 
 public slots:
-    void onChangeCalculated(beam::Amount change);
+    void onChangeCalculated(beam::Amount amount, beam::Amount change);
 
 private:
     void fillParameters(const beam::wallet::TxParameters& parameters);
@@ -24,12 +24,22 @@ SendViewModel::SendViewModel()
     : _feeGrothes(0)
     , _sendAmountGrothes(0)
     , _changeGrothes(0)
+    , _sendPending(false)
     , _walletModel(*AppModel::getInstance().getWallet())
 {
     connect(&_walletModel, &WalletModel::changeCalculated, this, &SendViewModel::onChangeCalculated);
     connect(&_walletModel, SIGNAL(sendMoneyVerified()), this, SIGNAL(sendMoneyVerified()));
     connect(&_walletModel, SIGNAL(cantSendToExpired()), this, SIGNAL(cantSendToExpired()));
     connect(&_walletModel, SIGNAL(availableChanged()), this, SIGNAL(availableChanged()));
+
+    // the coins for the change preview come from the store, the screen never reloads them
+    auto& utxoStore = AppModel::getInstance().getUtxoStore();
+    connect(&utxoStore, SIGNAL(utxosChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::Coin>&)),
+            SLOT(onAllUtxoChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::Coin>&)));
+    if (utxoStore.isLoaded())
+    {
+        _coinSelection.reset(utxoStore.getUtxos().getIds(UtxoViewStatus::Available));
+    }
 }
 
 unsigned int SendViewModel::getFeeGrothes() const
@@ -42,7 +52,7 @@ void SendViewModel::setFeeGrothes(unsigned int value)
     if (value != _feeGrothes)
     {
         _feeGrothes = value;
-        _walletModel.getAsync()->calcChange(calcTotalAmount());
+        updateChange();
         emit feeGrothesChanged();
         emit canSendChanged();
     }
@@ -75,7 +85,7 @@ void SendViewModel::setSendAmount(QString value)
     {
         _sendAmountGrothes = amount;
         LOG_INFO() << "Send amount: " << _sendAmountGrothes << " Coins: " << (long double)_sendAmountGrothes / beam::Rules::Coin;
-        _walletModel.getAsync()->calcChange(calcTotalAmount());
+        updateChange();
         emit sendAmountChanged();
         emit canSendChanged();
     }
@@ -150,11 +160,64 @@ bool SendViewModel::isEnough() const
     return _walletModel.getAvailable() >= calcTotalAmount() + _changeGrothes;
 }
 
-void SendViewModel::onChangeCalculated(beam::Amount change)
+void SendViewModel::onChangeCalculated(beam::Amount amount, beam::Amount change)
 {
+    // a reply for an amount typed before doesn't match the current preview,
+    // a pending send asks again for the amount it will actually send
+    if (amount != calcTotalAmount())
+    {
+        if (_sendPending)
+        {
+            _walletModel.calcChange(calcTotalAmount());
+        }
+        return;
+    }
+
+    // the change of the wallet replaces the preview one, the change coin comes or goes with it
+    if (_coinSelection.isLoaded())
+    {
+        _selection.resultingUtxos += (change > 0 ? 1 : 0);
+        _selection.resultingUtxos -= (_selection.change > 0 ? 1 : 0);
+    }
+    _selection.change = change;
     _changeGrothes = change;
     emit availableChanged();
     emit canSendChanged();
+
+    if (_sendPending)
+    {
+        _sendPending = false;
+        if (canSend())
+        {
+            startTransaction();
+        }
+        else
+        {
+            // the change of the wallet differs from the preview, the corrected amounts are already out
+            emit sendMoneyFailed();
+        }
+    }
+}
+
+void SendViewModel::onAllUtxoChanged(beam::wallet::ChangeAction action, const SharedItems<beam::wallet::Coin>& utxos)
+{
+    _coinSelection.apply(action, *utxos);
+    updateChange();
+}
+
+// the preview answers right away, the wallet is asked only until the coins are loaded
+void SendViewModel::updateChange()
+{
+    if (!_coinSelection.isLoaded())
+    {
+        _walletModel.calcChange(calcTotalAmount());
+        return;
+    }
+
+    _selection = _coinSelection.select(calcTotalAmount());
+    _changeGrothes = _selection.change;
+    emit availableChanged();
+    emit canSendChanged();
 }
 
 QString SendViewModel::getChange() const
@@ -172,6 +235,16 @@ QString SendViewModel::getMaxAvailable() const
     return beamui::AmountToUIString(_walletModel.getAvailable() - _feeGrothes);
 }
 
+int SendViewModel::getInputsCount() const
+{
+    return static_cast<int>(_selection.inputs);
+}
+
+int SendViewModel::getResultingUtxoCount() const
+{
+    return static_cast<int>(_selection.resultingUtxos);
+}
+
 bool SendViewModel::canSend() const
 {
     return !QMLGlobals::isSwapToken(_receiverTA) && getRreceiverTAValid()
@@ -184,23 +257,30 @@ void SendViewModel::sendMoney()
     assert(canSend());
     if(canSend())
     {
-        // TODO:SWAP show 'operation in process' animation here?
-        auto messageString = _comment.toStdString();
+        // the change shown is a preview, the wallet confirms it before the transaction starts
+        _sendPending = true;
+        _walletModel.calcChange(calcTotalAmount());
+    }
+}
 
-        auto p = beam::wallet::CreateSimpleTransactionParameters()
-            .SetParameter(beam::wallet::TxParameterID::PeerID,  *_txParameters.GetParameter<beam::wallet::WalletID>(beam::wallet::TxParameterID::PeerID))
-            .SetParameter(beam::wallet::TxParameterID::Amount,  _sendAmountGrothes)
-            .SetParameter(beam::wallet::TxParameterID::Fee,     _feeGrothes)
-            .SetParameter(beam::wallet::TxParameterID::Message, beam::ByteBuffer(messageString.begin(), messageString.end()));
+void SendViewModel::startTransaction()
+{
+    // TODO:SWAP show 'operation in process' animation here?
+    auto messageString = _comment.toStdString();
 
-        auto identity = _txParameters.GetParameter<beam::PeerID>(beam::wallet::TxParameterID::PeerSecureWalletID);
-        if (identity)
-        {
-            p.SetParameter(beam::wallet::TxParameterID::PeerSecureWalletID, *identity);
-        }
+    auto p = beam::wallet::CreateSimpleTransactionParameters()
+        .SetParameter(beam::wallet::TxParameterID::PeerID,  *_txParameters.GetParameter<beam::wallet::WalletID>(beam::wallet::TxParameterID::PeerID))
+        .SetParameter(beam::wallet::TxParameterID::Amount,  _sendAmountGrothes)
+        .SetParameter(beam::wallet::TxParameterID::Fee,     _feeGrothes)
+        .SetParameter(beam::wallet::TxParameterID::Message, beam::ByteBuffer(messageString.begin(), messageString.end()));
 
-        _walletModel.getAsync()->startTransaction(std::move(p));
+    auto identity = _txParameters.GetParameter<beam::PeerID>(beam::wallet::TxParameterID::PeerSecureWalletID);
+    if (identity)
+    {
+        p.SetParameter(beam::wallet::TxParameterID::PeerSecureWalletID, *identity);
     }
+
+    _walletModel.getAsync()->startTransaction(std::move(p));
 }
 
 void SendViewModel::extractParameters()
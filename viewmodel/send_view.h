@@ -15,6 +15,7 @@
 
 #include <QObject>
 #include "model/wallet_model.h"
+#include "viewmodel/helpers/coin_selection_preview.h"
 
 class SendViewModel: public QObject
 {
@@ -34,6 +35,8 @@ class SendViewModel: public QObject
     Q_PROPERTY(QString  maxAvailable       READ getMaxAvailable                                 NOTIFY availableChanged)
     Q_PROPERTY(QString  missing            READ getMissing                                      NOTIFY availableChanged)
     Q_PROPERTY(bool     isEnough           READ isEnough                                        NOTIFY availableChanged)
+    Q_PROPERTY(int      inputsCount        READ getInputsCount                                  NOTIFY availableChanged)
+    Q_PROPERTY(int      resultingUtxoCount READ getResultingUtxoCount                           NOTIFY availableChanged)
     Q_PROPERTY(bool     canSend            READ canSend                                         NOTIFY canSendChanged)
 
 public:
@@ -58,6 +61,8 @@ public:
     QString getChange() const;
     QString getTotalUTXO() const;
     QString getMaxAvailable() const;
+    int getInputsCount() const;
+    int getResultingUtxoCount() const;
 
     bool isEnough() const;
     bool canSend() const;
@@ -72,19 +77,27 @@ signals:
     void receiverTAChanged();
     void availableChanged();
     void sendMoneyVerified();
+    void sendMoneyFailed();
     void cantSendToExpired();
     void canSendChanged();
 
 public slots:
-    void onChangeCalculated(beam::Amount change);
+    void onChangeCalculated(beam::Amount amount, beam::Amount change);
+    void onAllUtxoChanged(beam::wallet::ChangeAction action, const SharedItems<beam::wallet::Coin>& utxos);
 
 private:
     beam::Amount calcTotalAmount() const;
     void extractParameters();
+    void updateChange();
+    void startTransaction();
 
     beam::Amount _feeGrothes;
     beam::Amount _sendAmountGrothes;
     beam::Amount _changeGrothes;
+    CoinSelectionPreview::Selection _selection;
+    CoinSelectionPreview _coinSelection;
+    // the transaction is started once the wallet has confirmed the change
+    bool _sendPending;
 
     QString _comment;
     QString _receiverTA;
@@ -0,0 +1,76 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#include "utxo_aggregates.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace beam;
+
+void UtxoAggregates::add(UtxoViewStatus::EnStatus status, UtxoViewType::EnType type, Amount amount)
+{
+    auto& cell = m_cells[status * kTypeCount + type];
+    ++cell.count;
+    cell.sum += amount;
+    ++cell.amounts[amount];
+}
+
+void UtxoAggregates::remove(UtxoViewStatus::EnStatus status, UtxoViewType::EnType type, Amount amount)
+{
+    auto& cell = m_cells[status * kTypeCount + type];
+    auto it = cell.amounts.find(amount);
+    if (it == cell.amounts.end())
+    {
+        assert(false && "Unknown coin");
+        return;
+    }
+    if (--it->second == 0)
+    {
+        cell.amounts.erase(it);
+    }
+    --cell.count;
+    cell.sum -= amount;
+}
+
+void UtxoAggregates::clear()
+{
+    m_cells = decltype(m_cells)();
+}
+
+UtxoAggregates::Totals UtxoAggregates::get(int status, int type) const
+{
+    Totals totals;
+    for (int s = 0; s < kStatusCount; ++s)
+    {
+        for (int t = 0; t < kTypeCount; ++t)
+        {
+            const auto& cell = m_cells[s * kTypeCount + t];
+            if (cell.count == 0 || !matches(status, s) || !matches(type, t))
+            {
+                continue;
+            }
+            const auto min = cell.amounts.begin()->first;
+            const auto max = cell.amounts.rbegin()->first;
+            totals.min = totals.count ? std::min(totals.min, min) : min;
+            totals.max = totals.count ? std::max(totals.max, max) : max;
+            totals.count += cell.count;
+            totals.sum += cell.sum;
+        }
+    }
+    return totals;
+}
+
+bool UtxoAggregates::matches(int filter, int value)
+{
+    return filter == kAny || filter == value;
+}
@@ -0,0 +1,59 @@
+// Copyright 2019 The Beam Team
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//    http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+#pragma once
+
+#include "wallet/core/common.h"
+#include "utxo_view_status.h"
+#include "utxo_view_type.h"
+#include <array>
+#include <map>
+
+// Count, sum, min and max of the coin amounts per status and type,
+// kept up to date coin by coin instead of being recomputed from the whole list
+class UtxoAggregates
+{
+public:
+    static constexpr int kAny = -1;
+
+    struct Totals
+    {
+        int count = 0;
+        beam::Amount sum = 0;
+        beam::Amount min = 0;
+        beam::Amount max = 0;
+    };
+
+    void add(UtxoViewStatus::EnStatus status, UtxoViewType::EnType type, beam::Amount amount);
+    void remove(UtxoViewStatus::EnStatus status, UtxoViewType::EnType type, beam::Amount amount);
+    void clear();
+
+    // kAny as the status or the type sums up over all of them
+    Totals get(int status, int type) const;
+
+private:
+    static constexpr int kStatusCount = UtxoViewStatus::Spent + 1;
+    static constexpr int kTypeCount = UtxoViewType::Treasury + 1;
+
+    struct Cell
+    {
+        int count = 0;
+        beam::Amount sum = 0;
+        // amount -> number of coins, gives min and max after a removal
+        std::map<beam::Amount, int> amounts;
+    };
+
+    static bool matches(int filter, int value);
+
+    std::array<Cell, kStatusCount * kTypeCount> m_cells;
+};
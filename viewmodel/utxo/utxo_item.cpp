@@ -30,10 +30,45 @@ namespace
             return lf > rt;
         return lf < rt;
     }
+
+    UtxoViewStatus::EnStatus toViewStatus(Coin::Status status)
+    {
+        switch (status)
+        {
+        case Coin::Available:
+            return UtxoViewStatus::Available;
+        case Coin::Maturing:
+            return UtxoViewStatus::Maturing;
+        case Coin::Unavailable:
+            return UtxoViewStatus::Unavailable;
+        case Coin::Outgoing:
+            return UtxoViewStatus::Outgoing;
+        case Coin::Incoming:
+            return UtxoViewStatus::Incoming;
+        case Coin::Spent:
+            return UtxoViewStatus::Spent;
+        default:
+            assert(false && "Unknown key type");
+        }
+
+        return UtxoViewStatus::Undefined;
+    }
 }
 
 UtxoItem::UtxoItem(const beam::wallet::Coin& coin)
-    : _coin{ coin }
+    : _id{ coin.m_ID }
+    , _maturity{ coin.get_Maturity() }
+    , _maturityValid{ coin.IsMaturityValid() }
+    , _status{ toViewStatus(coin.m_status) }
+{
+
+}
+
+UtxoItem::UtxoItem(const beam::wallet::Coin::ID& id, beam::Height maturity, bool maturityValid, UtxoViewStatus::EnStatus status)
+    : _id{ id }
+    , _maturity{ maturity }
+    , _maturityValid{ maturityValid }
+    , _status{ status }
 {
 
 }
@@ -55,37 +90,24 @@ QString UtxoItem::getAmount() const
 
 QString UtxoItem::maturity() const
 {
-    if (!_coin.IsMaturityValid())
+    if (!_maturityValid)
         return QString{ "-" };
-    return QString::number(_coin.m_maturity);
+    return QString::number(_maturity);
 }
 
 UtxoViewStatus::EnStatus UtxoItem::status() const
 {
-    switch (_coin.m_status)
-    {
-    case Coin::Available:
-        return UtxoViewStatus::Available;
-    case Coin::Maturing:
-        return UtxoViewStatus::Maturing;
-    case Coin::Unavailable:
-        return UtxoViewStatus::Unavailable;
-    case Coin::Outgoing:
-        return UtxoViewStatus::Outgoing;
-    case Coin::Incoming:
-        return UtxoViewStatus::Incoming;
-    case Coin::Spent:
-        return UtxoViewStatus::Spent;
-    default:
-        assert(false && "Unknown key type");
-    }
-
-    return UtxoViewStatus::Undefined;
+    return _status;
 }
 
 UtxoViewType::EnType UtxoItem::type() const
 {
-    switch (_coin.m_ID.m_Type)
+    return typeOf(_id);
+}
+
+UtxoViewType::EnType UtxoItem::typeOf(const beam::wallet::Coin::ID& id)
+{
+    switch (id.m_Type)
     {
     case Key::Type::Comission: return UtxoViewType::Comission;
     case Key::Type::Coinbase: return UtxoViewType::Coinbase;
@@ -99,15 +121,25 @@ UtxoViewType::EnType UtxoItem::type() const
 
 beam::Amount UtxoItem::rawAmount() const
 {
-    return _coin.m_ID.m_Value;
+    return _id.m_Value;
 }
 
 const beam::wallet::Coin::ID& UtxoItem::get_ID() const
 {
-    return _coin.m_ID;
+    return _id;
+}
+
+const beam::wallet::Coin::ID& UtxoItem::getKey() const
+{
+    return _id;
 }
 
 beam::Height UtxoItem::rawMaturity() const
 {
-    return _coin.get_Maturity();
+    return _maturity;
+}
+
+bool UtxoItem::isMaturityValid() const
+{
+    return _maturityValid;
 }
@@ -13,22 +13,19 @@
 // limitations under the License.
 #pragma once
 
-#include <QObject>
+#include <QString>
 #include "wallet/client/wallet_client.h"
 #include "utxo_view_status.h"
 #include "utxo_view_type.h"
 
-class UtxoItem : public QObject
+// The fields of a coin shown on the UTXO screen, the coin itself is not kept
+class UtxoItem
 {
-    Q_OBJECT
-        Q_PROPERTY(QString amount       READ getAmountWithCurrency     NOTIFY changed)
-        Q_PROPERTY(QString maturity     READ maturity                  NOTIFY changed)
-        Q_PROPERTY(int status           READ status                    NOTIFY changed)
-        Q_PROPERTY(int type             READ type                      NOTIFY changed)
 public:
 
     UtxoItem() = default;
     UtxoItem(const beam::wallet::Coin& coin);
+    UtxoItem(const beam::wallet::Coin::ID& id, beam::Height maturity, bool maturityValid, UtxoViewStatus::EnStatus status);
     bool operator==(const UtxoItem& other) const;
 
     QString getAmountWithCurrency() const;
@@ -40,11 +37,15 @@ public:
     beam::Amount rawAmount() const;
     beam::Height rawMaturity() const;
     const beam::wallet::Coin::ID& get_ID() const;
+    const beam::wallet::Coin::ID& getKey() const;
+    bool isMaturityValid() const;
 
-signals:
-    void changed();
+    static UtxoViewType::EnType typeOf(const beam::wallet::Coin::ID& id);
 
 private:
-    beam::wallet::Coin _coin;
+    beam::wallet::Coin::ID _id;
+    beam::Height _maturity = 0;
+    bool _maturityValid = false;
+    UtxoViewStatus::EnStatus _status = UtxoViewStatus::Undefined;
 };
 
@@ -14,10 +14,29 @@
 
 #include "utxo_item_list.h"
 
+namespace
+{
+
+const beam::wallet::Coin::ID& idOf(const beam::wallet::Coin& coin)
+{
+    return coin.m_ID;
+}
+
+}  // namespace
+
 UtxoItemList::UtxoItemList()
 {
 }
 
+int UtxoItemList::rowCount(const QModelIndex &parent) const
+{
+    if (parent.isValid())
+    {
+        return 0;
+    }
+    return static_cast<int>(m_ids.size());
+}
+
 QHash<int, QByteArray> UtxoItemList::roleNames() const
 {
     static const auto roles = QHash<int, QByteArray>
@@ -29,42 +48,320 @@ QHash<int, QByteArray> UtxoItemList::roleNames() const
         { static_cast<int>(Roles::Status), "status" },
         { static_cast<int>(Roles::StatusSort), "statusSort" },
         { static_cast<int>(Roles::Type), "type" },
-        { static_cast<int>(Roles::TypeSort), "typeSort" }
+        { static_cast<int>(Roles::TypeSort), "typeSort" },
+        { static_cast<int>(Roles::MaturedAtTip), "maturedAtTip" }
     };
     return roles;
 }
 
 auto UtxoItemList::data(const QModelIndex &index, int role) const -> QVariant
 {
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_list.size())
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
     {
        return QVariant();
     }
     
-    auto& value = m_list[index.row()];
+    const auto value = get(index.row());
     switch (static_cast<Roles>(role))
     {
         case Roles::Amount:
-            return value->getAmountWithCurrency();
+            return value.getAmountWithCurrency();
             
         case Roles::AmountSort:
-            return static_cast<qulonglong>(value->rawAmount());
+            return static_cast<qulonglong>(value.rawAmount());
 
         case Roles::Maturity:
-            return value->maturity();
+            return value.maturity();
         case Roles::MaturitySort:
-            return static_cast<qulonglong>(value->rawMaturity());
+            return static_cast<qulonglong>(value.rawMaturity());
 
         case Roles::Status:
         case Roles::StatusSort:
-            return value->status();
+            return value.status();
 
         case Roles::Type:
         case Roles::TypeSort:
-            return value->type();
+            return value.type();
+
+        case Roles::MaturedAtTip:
+            return isMaturedAtTip(index.row());
 
         default:
             return QVariant();
     }
 }
 
+// the keys are taken from the columns, no row is put together for them
+auto UtxoItemList::sortKeys(int role, Qt::CaseSensitivity, std::vector<quint64>& keys) const -> bool
+{
+    keys.resize(m_ids.size());
+    return updateSortKeys(role, 0, static_cast<int>(m_ids.size()) - 1, keys);
+}
+
+auto UtxoItemList::updateSortKeys(int role, int first, int last, std::vector<quint64>& keys) const -> bool
+{
+    // every sort role of the coins is a plain number
+    const auto from = static_cast<size_t>(first);
+    const auto to = static_cast<size_t>(last + 1);
+    switch (static_cast<Roles>(role))
+    {
+        case Roles::AmountSort:
+            std::transform(m_ids.begin() + from, m_ids.begin() + to, keys.begin() + from, [](const auto& id) { return static_cast<quint64>(id.m_Value); });
+            return true;
+
+        case Roles::MaturitySort:
+            std::copy(m_maturities.begin() + from, m_maturities.begin() + to, keys.begin() + from);
+            return true;
+
+        case Roles::StatusSort:
+            std::copy(m_statuses.begin() + from, m_statuses.begin() + to, keys.begin() + from);
+            return true;
+
+        case Roles::TypeSort:
+            std::transform(m_ids.begin() + from, m_ids.begin() + to, keys.begin() + from, [](const auto& id) { return static_cast<quint64>(UtxoItem::typeOf(id)); });
+            return true;
+
+        default:
+            return false;
+    }
+}
+
+UtxoItem UtxoItemList::get(int row) const
+{
+    return UtxoItem(m_ids.at(row), m_maturities[row], m_maturityValid[row], static_cast<UtxoViewStatus::EnStatus>(m_statuses[row]));
+}
+
+const UtxoAggregates& UtxoItemList::getAggregates() const
+{
+    return m_aggregates;
+}
+
+std::vector<beam::wallet::Coin::ID> UtxoItemList::getIds(UtxoViewStatus::EnStatus status) const
+{
+    std::vector<beam::wallet::Coin::ID> ids;
+    for (size_t row = 0; row < m_ids.size(); ++row)
+    {
+        if (m_statuses[row] == static_cast<quint8>(status))
+        {
+            ids.push_back(m_ids[row]);
+        }
+    }
+    return ids;
+}
+
+int UtxoItemList::setCurrentHeight(beam::Height height)
+{
+    m_currentHeight = height;
+    const QVector<int> roles = { static_cast<int>(Roles::MaturedAtTip) };
+    int matured = 0;
+    for (auto it = m_maturing.begin(); it != m_maturing.end() && it->first <= height; it = m_maturing.erase(it))
+    {
+        for (const auto& id : it->second.ids)
+        {
+            auto row = m_index.find(id);
+            if (row == m_index.end())
+            {
+                continue;
+            }
+            // the status and the totals change when the wallet reports the coin available
+            const auto modelIndex = index(row->second);
+            emit dataChanged(modelIndex, modelIndex, roles);
+            ++matured;
+        }
+    }
+    return matured;
+}
+
+auto UtxoItemList::getMaturityHistogram(beam::Height from, beam::Height to) const -> std::vector<std::pair<beam::Height, MaturityBucket>>
+{
+    std::vector<std::pair<beam::Height, MaturityBucket>> histogram;
+    for (auto it = m_maturing.upper_bound(from); it != m_maturing.end() && it->first <= to; ++it)
+    {
+        MaturityBucket bucket;
+        bucket.count = static_cast<int>(it->second.ids.size());
+        bucket.amount = it->second.amount;
+        histogram.emplace_back(it->first, bucket);
+    }
+    return histogram;
+}
+
+void UtxoItemList::reset(const std::vector<beam::wallet::Coin>& coins)
+{
+    auto removedRows = listmodel::rowsMissingFrom(coins, idOf, rowCount(), [this](int row) { return m_ids[row]; });
+
+    // nothing survives, plain model reset is cheaper than the diff
+    if (removedRows.size() == m_ids.size())
+    {
+        beginResetModel();
+        clear();
+        m_ids.reserve(coins.size());
+        m_maturities.reserve(coins.size());
+        m_maturityValid.reserve(coins.size());
+        m_statuses.reserve(coins.size());
+        for (const auto& coin : coins)
+        {
+            auto p = m_index.emplace(coin.m_ID, rowCount());
+            if (p.second)
+            {
+                append(UtxoItem(coin));
+            }
+            else
+            {
+                set(p.first->second, UtxoItem(coin));
+            }
+        }
+        endResetModel();
+        return;
+    }
+
+    removeRows(std::move(removedRows));
+    upsert(coins);
+}
+
+void UtxoItemList::insert(const std::vector<beam::wallet::Coin>& coins)
+{
+    upsert(coins);
+}
+
+void UtxoItemList::update(const std::vector<beam::wallet::Coin>& coins)
+{
+    upsert(coins);
+}
+
+void UtxoItemList::remove(const std::vector<beam::wallet::Coin>& coins)
+{
+    removeRows(listmodel::rowsOf(m_index, coins, idOf));
+}
+
+// new coins are appended with a single notification, the others replace their rows
+void UtxoItemList::upsert(const std::vector<beam::wallet::Coin>& coins)
+{
+    std::vector<size_t> newCoins;
+    std::vector<std::pair<int, size_t>> changedCoins;
+    listmodel::splitBatch(m_index, rowCount(), coins, idOf, newCoins, changedCoins);
+
+    if (!newCoins.empty())
+    {
+        const int first = rowCount();
+        beginInsertRows(QModelIndex(), first, first + static_cast<int>(newCoins.size()) - 1);
+        for (auto i : newCoins)
+        {
+            append(UtxoItem(coins[i]));
+        }
+        endInsertRows();
+    }
+
+    for (const auto& [row, i] : changedCoins)
+    {
+        const auto roles = set(row, UtxoItem(coins[i]));
+        if (!roles.isEmpty())
+        {
+            const auto modelIndex = index(row);
+            emit dataChanged(modelIndex, modelIndex, roles);
+        }
+    }
+}
+
+// removes the rows with one notification per contiguous range
+void UtxoItemList::removeRows(std::vector<int> rows)
+{
+    const int moved = listmodel::removeRanges(std::move(rows), [this](int first, int last)
+    {
+        beginRemoveRows(QModelIndex(), first, last);
+        for (int row = first; row <= last; ++row)
+        {
+            removeMaturing(row);
+            m_index.erase(m_ids[row]);
+            m_aggregates.remove(static_cast<UtxoViewStatus::EnStatus>(m_statuses[row]), UtxoItem::typeOf(m_ids[row]), m_ids[row].m_Value);
+        }
+        m_ids.erase(m_ids.begin() + first, m_ids.begin() + last + 1);
+        m_maturities.erase(m_maturities.begin() + first, m_maturities.begin() + last + 1);
+        m_maturityValid.erase(m_maturityValid.begin() + first, m_maturityValid.begin() + last + 1);
+        m_statuses.erase(m_statuses.begin() + first, m_statuses.begin() + last + 1);
+        endRemoveRows();
+    });
+    if (moved >= 0)
+    {
+        listmodel::reindex(m_index, moved, rowCount(), [this](int row) { return m_ids[row]; });
+    }
+}
+
+void UtxoItemList::append(const UtxoItem& item)
+{
+    m_ids.push_back(item.get_ID());
+    m_maturities.push_back(item.rawMaturity());
+    m_maturityValid.push_back(item.isMaturityValid());
+    m_statuses.push_back(static_cast<quint8>(item.status()));
+    m_aggregates.add(item.status(), item.type(), item.rawAmount());
+    addMaturing(rowCount() - 1);
+}
+
+// the ID holds the amount and the type, so only the maturity and the status can change,
+// returns the roles which values are different now
+QVector<int> UtxoItemList::set(int row, const UtxoItem& item)
+{
+    removeMaturing(row);
+    QVector<int> roles;
+    if (m_maturities[row] != item.rawMaturity() || m_maturityValid[row] != item.isMaturityValid())
+    {
+        m_maturities[row] = item.rawMaturity();
+        m_maturityValid[row] = item.isMaturityValid();
+        // the status text of a maturing coin shows its maturity
+        roles << static_cast<int>(Roles::Maturity) << static_cast<int>(Roles::MaturitySort) << static_cast<int>(Roles::Status)
+              << static_cast<int>(Roles::MaturedAtTip);
+    }
+    if (m_statuses[row] != static_cast<quint8>(item.status()))
+    {
+        m_aggregates.remove(static_cast<UtxoViewStatus::EnStatus>(m_statuses[row]), item.type(), item.rawAmount());
+        m_aggregates.add(item.status(), item.type(), item.rawAmount());
+        m_statuses[row] = static_cast<quint8>(item.status());
+        if (!roles.contains(static_cast<int>(Roles::Status)))
+        {
+            roles << static_cast<int>(Roles::Status) << static_cast<int>(Roles::MaturedAtTip);
+        }
+        roles << static_cast<int>(Roles::StatusSort);
+    }
+    addMaturing(row);
+    return roles;
+}
+
+void UtxoItemList::clear()
+{
+    m_ids.clear();
+    m_maturities.clear();
+    m_maturityValid.clear();
+    m_statuses.clear();
+    m_index.clear();
+    m_aggregates.clear();
+    m_maturing.clear();
+}
+
+void UtxoItemList::addMaturing(int row)
+{
+    if (m_statuses[row] == UtxoViewStatus::Maturing && m_maturityValid[row] && m_maturities[row] > m_currentHeight)
+    {
+        auto& coins = m_maturing[m_maturities[row]];
+        if (coins.ids.insert(m_ids[row]).second)
+        {
+            coins.amount += m_ids[row].m_Value;
+        }
+    }
+}
+
+void UtxoItemList::removeMaturing(int row)
+{
+    auto it = m_maturing.find(m_maturities[row]);
+    if (it != m_maturing.end() && it->second.ids.erase(m_ids[row]))
+    {
+        it->second.amount -= m_ids[row].m_Value;
+        if (it->second.ids.empty())
+        {
+            m_maturing.erase(it);
+        }
+    }
+}
+
+bool UtxoItemList::isMaturedAtTip(int row) const
+{
+    return m_statuses[row] == UtxoViewStatus::Maturing && m_maturityValid[row] && m_maturities[row] <= m_currentHeight;
+}
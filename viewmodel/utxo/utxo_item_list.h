@@ -15,9 +15,24 @@
 #pragma once
 
 #include "utxo_item.h"
+#include "utxo_aggregates.h"
 #include "viewmodel/helpers/list_model.h"
+#include <map>
+#include <set>
 
-class UtxoItemList : public ListModel<std::shared_ptr<UtxoItem>>
+template <>
+struct ListModelKeyHash<beam::wallet::Coin::ID>
+{
+    size_t operator()(const beam::wallet::Coin::ID& id) const
+    {
+        const uint64_t fields[] = { id.m_Idx, id.m_Value, (uint64_t(uint32_t(id.m_Type)) << 32) | id.m_SubIdx };
+        return qHashBits(fields, sizeof(fields));
+    }
+};
+
+// Coins are kept column by column, a row is put together only when the view asks for it,
+// so a wallet with a huge number of coins neither holds a copy of every coin nor an object per row
+class UtxoItemList : public QAbstractListModel, public SortKeySource
 {
 
     Q_OBJECT
@@ -32,11 +47,65 @@ public:
         Status,
         StatusSort,
         Type,
-        TypeSort
+        TypeSort,
+        MaturedAtTip
     };
 
     UtxoItemList();
 
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
+    bool sortKeys(int role, Qt::CaseSensitivity cs, std::vector<quint64>& keys) const override;
+    bool updateSortKeys(int role, int first, int last, std::vector<quint64>& keys) const override;
+
+    struct MaturityBucket
+    {
+        int count = 0;
+        beam::Amount amount = 0;
+    };
+
+    UtxoItem get(int row) const;
+    const UtxoAggregates& getAggregates() const;
+    // IDs of the coins in the status, the amount is part of the ID
+    std::vector<beam::wallet::Coin::ID> getIds(UtxoViewStatus::EnStatus status) const;
+
+    // maturing coins which mature by the height are reported through the MaturedAtTip role,
+    // their status stays the one the wallet reported; returns the number of them
+    int setCurrentHeight(beam::Height height);
+    // maturing coins per maturity height in (from, to]
+    std::vector<std::pair<beam::Height, MaturityBucket>> getMaturityHistogram(beam::Height from, beam::Height to) const;
+
+    // applies the snapshot as a diff against the current rows
+    void reset(const std::vector<beam::wallet::Coin>& coins);
+    void insert(const std::vector<beam::wallet::Coin>& coins);
+    void update(const std::vector<beam::wallet::Coin>& coins);
+    void remove(const std::vector<beam::wallet::Coin>& coins);
+
+private:
+    void upsert(const std::vector<beam::wallet::Coin>& coins);
+    void removeRows(std::vector<int> rows);
+    void append(const UtxoItem& item);
+    QVector<int> set(int row, const UtxoItem& item);
+    void clear();
+    void addMaturing(int row);
+    void removeMaturing(int row);
+    bool isMaturedAtTip(int row) const;
+
+    std::vector<beam::wallet::Coin::ID> m_ids;
+    std::vector<beam::Height> m_maturities;
+    std::vector<bool> m_maturityValid;
+    std::vector<quint8> m_statuses;
+    listmodel::RowIndex<beam::wallet::Coin::ID> m_index;
+    // follows every change of the columns
+    UtxoAggregates m_aggregates;
+
+    struct MaturingCoins
+    {
+        std::set<beam::wallet::Coin::ID> ids;
+        beam::Amount amount = 0;
+    };
+    // maturing coins by the height they mature at, the ones matured at the tip are not kept
+    std::map<beam::Height, MaturingCoins> m_maturing;
+    beam::Height m_currentHeight = 0;
 };
@@ -22,12 +22,13 @@ using namespace beamui;
 
 UtxoViewModel::UtxoViewModel()
     : _model{*AppModel::getInstance().getWallet()}
+    , _allUtxos{AppModel::getInstance().getUtxoStore().getUtxos()}
 {
-    connect(&_model, SIGNAL(allUtxoChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::Coin>&)),
-        SLOT(onAllUtxoChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::Coin>&)));
-    connect(&_model, SIGNAL(stateIDChanged()), SIGNAL(stateChanged()));
-
-    _model.getAsync()->getUtxosStatus();
+    connect(&AppModel::getInstance().getUtxoStore(),
+        SIGNAL(utxosChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::Coin>&)),
+        SLOT(onAllUtxoChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::Coin>&)));
+    connect(&AppModel::getInstance().getUtxoStore(), SIGNAL(utxosMatured()), SLOT(onUtxosMatured()));
+    connect(&_model, SIGNAL(stateIDChanged()), SLOT(onStateChanged()));
 }
 
 
@@ -46,46 +47,67 @@ QString UtxoViewModel::getCurrentStateHash() const
     return QString(beam::to_hex(_model.getCurrentStateID().m_Hash.m_pData, 10).c_str());
 }
 
-void UtxoViewModel::onAllUtxoChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::Coin>& utxos)
+QVariantList UtxoViewModel::getAggregates() const
 {
-    vector<shared_ptr<UtxoItem>> modifiedItems;
-    modifiedItems.reserve(utxos.size());
-
-    for (const auto& t : utxos)
-    {
-        modifiedItems.push_back(make_shared<UtxoItem>(t));
-    }
-
-    switch (action)
+    QVariantList aggregates;
+    for (int status = UtxoViewStatus::Undefined; status <= UtxoViewStatus::Spent; ++status)
     {
-    case ChangeAction::Reset:
-    {
-        _allUtxos.reset(modifiedItems);
-        break;
+        for (int type = UtxoViewType::Undefined; type <= UtxoViewType::Treasury; ++type)
+        {
+            auto aggregate = getAggregate(status, type);
+            if (aggregate["count"].toInt() > 0)
+            {
+                aggregates.push_back(aggregate);
+            }
+        }
     }
+    return aggregates;
+}
 
-    case ChangeAction::Removed:
+QVariantMap UtxoViewModel::getAggregate(int status, int type) const
+{
+    const auto totals = _allUtxos.getAggregates().get(status, type);
+    return QVariantMap
     {
-        _allUtxos.remove(modifiedItems);
-        break;
-    }
+        { "status", status },
+        { "type", type },
+        { "count", totals.count },
+        { "amount", AmountToUIString(totals.sum) },
+        { "min", AmountToUIString(totals.min) },
+        { "max", AmountToUIString(totals.max) }
+    };
+}
 
-    case ChangeAction::Added:
+QVariantList UtxoViewModel::getMaturityHistogram(int blocks) const
+{
+    const auto height = _model.getCurrentHeight();
+    QVariantList histogram;
+    for (const auto& [maturity, bucket] : _allUtxos.getMaturityHistogram(height, height + std::max(blocks, 0)))
     {
-        _allUtxos.insert(modifiedItems);
-        break;
+        histogram.push_back(QVariantMap
+        {
+            { "height", static_cast<qulonglong>(maturity) },
+            { "count", bucket.count },
+            { "amount", AmountToUIString(bucket.amount) }
+        });
     }
+    return histogram;
+}
 
-    case ChangeAction::Updated:
-    {
-        _allUtxos.update(modifiedItems);
-        break;
-    }
+void UtxoViewModel::onStateChanged()
+{
+    emit stateChanged();
+}
 
-    default:
-        assert(false && "Unexpected action");
-        break;
-    }
+void UtxoViewModel::onUtxosMatured()
+{
+    // the totals keep the status reported by the wallet, only the maturing coins are fewer
+    emit maturityChanged();
+}
 
-    emit allUtxoChanged();
+void UtxoViewModel::onAllUtxoChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::Coin>&)
+{
+    // the store has already applied the batch to the list
+    emit aggregatesChanged();
+    emit maturityChanged();
 }
@@ -15,8 +15,10 @@
 #pragma once
 
 #include <QObject>
+#include <QVariantList>
+#include <QVariantMap>
 #include "model/wallet_model.h"
-#include "utxo_item_list.h"
+#include "model/utxo_store.h"
 
 class UtxoViewModel : public QObject
 {
@@ -25,18 +27,31 @@ class UtxoViewModel : public QObject
     Q_PROPERTY(QAbstractItemModel* allUtxos  READ getAllUtxos          NOTIFY allUtxoChanged)
     Q_PROPERTY(QString currentHeight         READ getCurrentHeight     NOTIFY stateChanged)
     Q_PROPERTY(QString currentStateHash      READ getCurrentStateHash  NOTIFY stateChanged)
+    // count, amount, min and max of the coins of every status and type which has any
+    Q_PROPERTY(QVariantList aggregates       READ getAggregates        NOTIFY aggregatesChanged)
 
 public:
     UtxoViewModel();
     QAbstractItemModel* getAllUtxos();
     QString getCurrentHeight() const;
     QString getCurrentStateHash() const;
+    QVariantList getAggregates() const;
+    // UtxoAggregates::kAny (-1) as the status or the type sums up over all of them
+    Q_INVOKABLE QVariantMap getAggregate(int status, int type) const;
+    // maturing coins of the next blocks, one entry per height which has any
+    Q_INVOKABLE QVariantList getMaturityHistogram(int blocks) const;
 public slots:
-    void onAllUtxoChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::Coin>& utxos);
+    void onAllUtxoChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::Coin>& utxos);
+    void onStateChanged();
+    void onUtxosMatured();
 signals:
     void allUtxoChanged();
     void stateChanged();
+    void aggregatesChanged();
+    // coins have matured or started maturing, the histogram has to be read again
+    void maturityChanged();
 private:
-    UtxoItemList _allUtxos;
     WalletModel& _model;
+    // the coins are shown straight from the store, the screen keeps no copy of them
+    UtxoItemList& _allUtxos;
 };
\ No newline at end of file
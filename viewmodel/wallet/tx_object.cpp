@@ -78,16 +78,134 @@ namespace
         //% "It is taking longer than usual. In case the transaction could not be completed it will be canceled automatically in %1."
         return qtTrId("tx-state-in-progress-long").arg(time);
     }
-}
 
-TxObject::TxObject(QObject* parent)
-        : QObject(parent)
-{
+    using DisplayStatus = TxObject::DisplayStatus;
+
+    // translated labels, built on the first use and dropped by TxObject::retranslate()
+    struct Labels
+    {
+        std::array<QString, static_cast<size_t>(DisplayStatus::Count)> statuses;
+        std::array<QString, 31> reasons;
+    };
+
+    std::unique_ptr<Labels> makeLabels()
+    {
+        auto labels = std::make_unique<Labels>();
+        labels->statuses = {
+            //% "pending"
+            qtTrId("wallet-txs-status-pending"),
+            //% "waiting for sender"
+            qtTrId("wallet-txs-status-waiting-sender"),
+            //% "waiting for receiver"
+            qtTrId("wallet-txs-status-waiting-receiver"),
+            //% "in progress"
+            qtTrId("wallet-txs-status-in-progress"),
+            //% "sent to own address"
+            qtTrId("wallet-txs-status-own-sent"),
+            //% "sending to own address"
+            qtTrId("wallet-txs-status-own-sending"),
+            //% "received"
+            qtTrId("wallet-txs-status-received"),
+            //% "sent"
+            qtTrId("wallet-txs-status-sent"),
+            //% "cancelled"
+            qtTrId("wallet-txs-status-cancelled"),
+            //% "expired"
+            qtTrId("wallet-txs-status-expired"),
+            //% "failed"
+            qtTrId("wallet-txs-status-failed"),
+            //% "unknown"
+            qtTrId("wallet-txs-status-unknown")
+        };
+        labels->reasons = {
+            //% "Unexpected reason, please send wallet logs to Beam support"
+            qtTrId("tx-failure-undefined"),
+            //% "Transaction cancelled"
+            qtTrId("tx-failure-cancelled"),
+            //% "Receiver signature in not valid, please send wallet logs to Beam support"
+            qtTrId("tx-failure-receiver-signature-invalid"),
+            //% "Failed to register transaction with the blockchain, see node logs for details"
+            qtTrId("tx-failure-not-registered-in-blockchain"),
+            //% "Transaction is not valid, please send wallet logs to Beam support"
+            qtTrId("tx-failure-not-valid"),
+            //% "Invalid kernel proof provided"
+            qtTrId("tx-failure-kernel-invalid"),
+            //% "Failed to send Transaction parameters"
+            qtTrId("tx-failure-parameters-not-sended"),
+            //% "No inputs"
+            qtTrId("tx-failure-no-inputs"),
+            //% "Address is expired"
+            qtTrId("tx-failure-addr-expired"),
+            //% "Failed to get transaction parameters"
+            qtTrId("tx-failure-parameters-not-readed"),
+            //% "Transaction timed out"
+            qtTrId("tx-failure-time-out"),
+            //% "Payment not signed by the receiver, please send wallet logs to Beam support"
+            qtTrId("tx-failure-not-signed-by-receiver"),
+            //% "Kernel maximum height is too high"
+            qtTrId("tx-failure-max-height-to-high"),
+            //% "Transaction has invalid state"
+            qtTrId("tx-failure-invalid-state"),
+            //% "Subtransaction has failed"
+            qtTrId("tx-failure-subtx-failed"),
+            //% "Contract's amount is not valid"
+            qtTrId("tx-failure-invalid-contract-amount"),
+            //% "Side chain has invalid contract"
+            qtTrId("tx-failure-invalid-sidechain-contract"),
+            //% "Side chain bridge has internal error"
+            qtTrId("tx-failure-sidechain-internal-error"),
+            //% "Side chain bridge has network error"
+            qtTrId("tx-failure-sidechain-network-error"),
+            //% "Side chain bridge has response format error"
+            qtTrId("tx-failure-invalid-sidechain-response-format"),
+            //% "Invalid credentials of Side chain"
+            qtTrId("tx-failure-invalid-side-chain-credentials"),
+            //% "Not enough time to finish btc lock transaction"
+            qtTrId("tx-failure-not-enough-time-btc-lock"),
+            //% "Failed to create multi-signature"
+            qtTrId("tx-failure-create-multisig"),
+            //% "Fee is too small"
+            qtTrId("tx-failure-fee-too-small"),
+            //% "Kernel's min height is unacceptable"
+            qtTrId("tx-failure-kernel-min-height"),
+            //% "Not a loopback transaction"
+            qtTrId("tx-failure-loopback"),
+            //% "Key keeper is not initialized"
+            qtTrId("tx-failure-key-keeper-no-initialized"),
+            //% "No valid asset id/asset idx"
+            qtTrId("tx-failure-invalid-asset-id"),
+            //% "Cannot consume more than MAX_INT64 asset groth in one transaction"
+            qtTrId("tx-failure-invalid-asset-amount"),
+            //% "Some mandatory data for payment proof is missing"
+            qtTrId("tx-failure-invalid-data-for-payment-proof")
+        };
+        return labels;
+    }
+
+    std::unique_ptr<Labels> g_labels;
+
+    const Labels& getLabels()
+    {
+        if (!g_labels)
+        {
+            g_labels = makeLabels();
+        }
+        return *g_labels;
+    }
+
+    template<typename Func>
+    const QString& getCached(boost::optional<QString>& value, Func&& func)
+    {
+        if (!value)
+        {
+            value = func();
+        }
+        return *value;
+    }
 }
 
-TxObject::TxObject(const TxDescription& tx, QObject* parent/* = nullptr*/)
-        : QObject(parent)
-        , m_tx(tx)
+TxObject::TxObject(const TxDescription& tx)
+        : m_tx(tx)
         , m_type(*m_tx.GetParameter<TxType>(TxParameterID::TransactionType))
 {
     auto kernelID = QString::fromStdString(to_hex(m_tx.m_kernelID.m_pData, m_tx.m_kernelID.nBytes));
@@ -99,11 +217,26 @@ bool TxObject::operator==(const TxObject& other) const
     return getTxID() == other.getTxID();
 }
 
+auto TxObject::getKey() const -> beam::wallet::TxID
+{
+    return m_tx.m_txId;
+}
+
 auto TxObject::timeCreated() const -> beam::Timestamp
 {
     return m_tx.m_createTime;
 }
 
+auto TxObject::getTimeCreated() const -> QString
+{
+    return getCached(m_displayCache.timeCreated, [this]()
+    {
+        QDateTime datetime;
+        datetime.setTime_t(m_tx.m_createTime);
+        return datetime.toString(Qt::SystemLocaleShortDate);
+    });
+}
+
 auto TxObject::getTxID() const -> beam::wallet::TxID
 {
     return m_tx.m_txId;
@@ -116,18 +249,27 @@ bool TxObject::isIncome() const
 
 QString TxObject::getComment() const
 {
-    std::string str{ m_tx.m_message.begin(), m_tx.m_message.end() };
-    return QString(str.c_str()).trimmed();
+    return getCached(m_displayCache.comment, [this]()
+    {
+        std::string str{ m_tx.m_message.begin(), m_tx.m_message.end() };
+        return QString(str.c_str()).trimmed();
+    });
 }
 
 QString TxObject::getAmountWithCurrency() const
 {
-    return AmountToUIString(m_tx.m_amount, Currencies::Beam);
+    return getCached(m_displayCache.amountWithCurrency, [this]()
+    {
+        return AmountToUIString(m_tx.m_amount, Currencies::Beam);
+    });
 }
 
 QString TxObject::getAmount() const
 {
-    return AmountToUIString(m_tx.m_amount);
+    return getCached(m_displayCache.amount, [this]()
+    {
+        return AmountToUIString(m_tx.m_amount);
+    });
 }
 
 beam::Amount TxObject::getAmountValue() const
@@ -140,6 +282,56 @@ QString TxObject::getStatus() const
     return m_tx.getStatusString().c_str();
 }
 
+auto TxObject::getDisplayStatus() const -> DisplayStatus
+{
+    // mirrors TxDescription::getStatusString()
+    switch (m_tx.m_status)
+    {
+    case TxStatus::Pending:
+        return DisplayStatus::Pending;
+
+    case TxStatus::InProgress:
+        if (m_tx.m_selfTx)
+        {
+            return DisplayStatus::SendingToOwn;
+        }
+        return m_tx.m_sender ? DisplayStatus::WaitingForReceiver : DisplayStatus::WaitingForSender;
+
+    case TxStatus::Registering:
+        return m_tx.m_selfTx ? DisplayStatus::SendingToOwn : DisplayStatus::InProgress;
+
+    case TxStatus::Completed:
+        if (m_tx.m_selfTx)
+        {
+            return DisplayStatus::SentToOwn;
+        }
+        return m_tx.m_sender ? DisplayStatus::Sent : DisplayStatus::Received;
+
+    case TxStatus::Canceled:
+        return DisplayStatus::Cancelled;
+
+    case TxStatus::Failed:
+        if (m_tx.m_failureReason == TxFailureReason::TransactionExpired)
+        {
+            return DisplayStatus::Expired;
+        }
+        return DisplayStatus::Failed;
+
+    default:
+        return DisplayStatus::Unknown;
+    }
+}
+
+QString TxObject::getStatusTranslated() const
+{
+    return getLabels().statuses[static_cast<size_t>(getDisplayStatus())];
+}
+
+void TxObject::retranslate()
+{
+    g_labels.reset();
+}
+
 bool TxObject::isCancelAvailable() const
 {
     return m_tx.canCancel();
@@ -152,12 +344,18 @@ bool TxObject::isDeleteAvailable() const
 
 QString TxObject::getAddressFrom() const
 {
-    return toString(m_tx.m_sender ? m_tx.m_myId : m_tx.m_peerId);
+    return getCached(m_displayCache.addressFrom, [this]()
+    {
+        return toString(m_tx.m_sender ? m_tx.m_myId : m_tx.m_peerId);
+    });
 }
 
 QString TxObject::getAddressTo() const
 {
-    return toString(!m_tx.m_sender ? m_tx.m_myId : m_tx.m_peerId);
+    return getCached(m_displayCache.addressTo, [this]()
+    {
+        return toString(!m_tx.m_sender ? m_tx.m_myId : m_tx.m_peerId);
+    });
 }
 
 QString TxObject::getFee() const
@@ -176,11 +374,7 @@ const beam::wallet::TxDescription& TxObject::getTxDescription() const
 
 void TxObject::setStatus(beam::wallet::TxStatus status)
 {
-    if (m_tx.m_status != status)
-    {
-        m_tx.m_status = status;
-        emit statusChanged();
-    }
+    m_tx.m_status = status;
 }
 
 QString TxObject::getKernelID() const
@@ -190,82 +384,39 @@ QString TxObject::getKernelID() const
 
 void TxObject::setKernelID(const QString& value)
 {
-    if (m_kernelID != value)
-    {
-        m_kernelID = value;
-        emit kernelIDChanged();
-    }
+    m_kernelID = value;
+    m_displayCache.search.reset();
 }
 
 QString TxObject::getTransactionID() const
 {
-    return QString::fromStdString(to_hex(m_tx.m_txId.data(), m_tx.m_txId.size()));
+    return getCached(m_displayCache.transactionID, [this]()
+    {
+        return QString::fromStdString(to_hex(m_tx.m_txId.data(), m_tx.m_txId.size()));
+    });
+}
+
+QString TxObject::getSearchString() const
+{
+    // searchable fields joined once per row, the filter matches them with its own case sensitivity
+    return getCached(m_displayCache.search, [this]()
+    {
+        QString r = getTransactionID();
+        r.append(" ");
+        r.append(getKernelID());
+        r.append(" ");
+        r.append(getAddressFrom());
+        r.append(" ");
+        r.append(getAddressTo());
+        r.append(" ");
+        r.append(getComment());
+        return r;
+    });
 }
 
 QString TxObject::getReasonString(beam::wallet::TxFailureReason reason) const
 {
-    const std::array<QString,31> reasons = {
-        //% "Unexpected reason, please send wallet logs to Beam support"
-        qtTrId("tx-failure-undefined"),
-        //% "Transaction cancelled"
-        qtTrId("tx-failure-cancelled"),
-        //% "Receiver signature in not valid, please send wallet logs to Beam support"
-        qtTrId("tx-failure-receiver-signature-invalid"),
-        //% "Failed to register transaction with the blockchain, see node logs for details"
-        qtTrId("tx-failure-not-registered-in-blockchain"),
-        //% "Transaction is not valid, please send wallet logs to Beam support"
-        qtTrId("tx-failure-not-valid"),
-        //% "Invalid kernel proof provided"
-        qtTrId("tx-failure-kernel-invalid"),
-        //% "Failed to send Transaction parameters"
-        qtTrId("tx-failure-parameters-not-sended"),
-        //% "No inputs"
-        qtTrId("tx-failure-no-inputs"),
-        //% "Address is expired"
-        qtTrId("tx-failure-addr-expired"),
-        //% "Failed to get transaction parameters"
-        qtTrId("tx-failure-parameters-not-readed"),
-        //% "Transaction timed out"
-        qtTrId("tx-failure-time-out"),
-        //% "Payment not signed by the receiver, please send wallet logs to Beam support"
-        qtTrId("tx-failure-not-signed-by-receiver"),
-        //% "Kernel maximum height is too high"
-        qtTrId("tx-failure-max-height-to-high"),
-        //% "Transaction has invalid state"
-        qtTrId("tx-failure-invalid-state"),
-        //% "Subtransaction has failed"
-        qtTrId("tx-failure-subtx-failed"),
-        //% "Contract's amount is not valid"
-        qtTrId("tx-failure-invalid-contract-amount"),
-        //% "Side chain has invalid contract"
-        qtTrId("tx-failure-invalid-sidechain-contract"),
-        //% "Side chain bridge has internal error"
-        qtTrId("tx-failure-sidechain-internal-error"),
-        //% "Side chain bridge has network error"
-        qtTrId("tx-failure-sidechain-network-error"),
-        //% "Side chain bridge has response format error"
-        qtTrId("tx-failure-invalid-sidechain-response-format"),
-        //% "Invalid credentials of Side chain"
-        qtTrId("tx-failure-invalid-side-chain-credentials"),
-        //% "Not enough time to finish btc lock transaction"
-        qtTrId("tx-failure-not-enough-time-btc-lock"),
-        //% "Failed to create multi-signature"
-        qtTrId("tx-failure-create-multisig"),
-        //% "Fee is too small"
-        qtTrId("tx-failure-fee-too-small"),
-        //% "Kernel's min height is unacceptable"
-        qtTrId("tx-failure-kernel-min-height"),
-        //% "Not a loopback transaction"
-        qtTrId("tx-failure-loopback"),
-        //% "Key keeper is not initialized"
-        qtTrId("tx-failure-key-keeper-no-initialized"),
-        //% "No valid asset id/asset idx"
-        qtTrId("tx-failure-invalid-asset-id"),
-        //% "Cannot consume more than MAX_INT64 asset groth in one transaction"
-        qtTrId("tx-failure-invalid-asset-amount"),
-        //% "Some mandatory data for payment proof is missing"
-        qtTrId("tx-failure-invalid-data-for-payment-proof")
-    };
+    const auto& reasons = getLabels().reasons;
     assert(reasons.size() > static_cast<size_t>(reason));
     return reasons[reason];
 }
@@ -283,11 +434,7 @@ QString TxObject::getFailureReason() const
 
 void TxObject::setFailureReason(beam::wallet::TxFailureReason reason)
 {
-    if (m_tx.m_failureReason != reason)
-    {
-        m_tx.m_failureReason = reason;
-        emit failureReasonChanged();
-    }
+    m_tx.m_failureReason = reason;
 }
 
 QString TxObject::getStateDetails() const
@@ -336,6 +483,21 @@ void TxObject::update(const beam::wallet::TxDescription& tx)
     setFailureReason(tx.m_failureReason);
 }
 
+void TxObject::resetDisplayCache()
+{
+    m_displayCache = DisplayCache();
+}
+
+void TxObject::prepareDisplay() const
+{
+    getAmountWithCurrency();
+    getAmount();
+    getAddressFrom();
+    getAddressTo();
+    getComment();
+    getSearchString();
+}
+
 bool TxObject::isInProgress() const
 {
     switch (m_tx.m_status)
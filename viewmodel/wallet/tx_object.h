@@ -13,21 +13,43 @@
 // limitations under the License.
 #pragma once
 
-#include <QObject>
 #include <QDateTime>
 #include "viewmodel/payment_item.h"
 #include "viewmodel/ui_helpers.h"
 
-class TxObject : public QObject
+class TxObject
 {
-    Q_OBJECT
-
 public:
-    TxObject(QObject* parent = nullptr);
-    TxObject(const beam::wallet::TxDescription& tx, QObject* parent = nullptr);
+    // order matches the translated labels table
+    enum class DisplayStatus
+    {
+        Pending,
+        WaitingForSender,
+        WaitingForReceiver,
+        InProgress,
+        SentToOwn,
+        SendingToOwn,
+        Received,
+        Sent,
+        Cancelled,
+        Expired,
+        Failed,
+        Unknown,
+        Count
+    };
+
+    TxObject() = default;
+    TxObject(const beam::wallet::TxDescription& tx);
+    TxObject(const TxObject&) = default;
+    TxObject(TxObject&&) = default;
+    TxObject& operator=(const TxObject&) = default;
+    TxObject& operator=(TxObject&&) = default;
+    virtual ~TxObject() = default;
     bool operator==(const TxObject& other) const;
 
+    auto getKey() const -> beam::wallet::TxID;
     auto timeCreated() const -> beam::Timestamp;
+    auto getTimeCreated() const -> QString;
     auto getTxID() const -> beam::wallet::TxID;
     auto getAmountWithCurrency() const->QString;
     auto getAmount() const -> QString;
@@ -38,8 +60,11 @@ public:
     virtual auto getFee() const -> QString;
     auto getKernelID() const -> QString;
     auto getTransactionID() const -> QString;
+    auto getSearchString() const -> QString;
     auto hasPaymentProof() const -> bool;
     virtual auto getStatus() const -> QString;
+    auto getDisplayStatus() const -> DisplayStatus;
+    auto getStatusTranslated() const -> QString;
     virtual auto getFailureReason() const -> QString;
     virtual QString getStateDetails() const;
 
@@ -58,17 +83,35 @@ public:
     void setStatus(beam::wallet::TxStatus status);
     void setFailureReason(beam::wallet::TxFailureReason reason);
     void update(const beam::wallet::TxDescription& tx);
+    void resetDisplayCache();
+    // formats the display strings which don't depend on the language, rows built
+    // off the UI thread come with them ready
+    void prepareDisplay() const;
 
-signals:
-    void statusChanged();
-    void kernelIDChanged();
-    void failureReasonChanged();
+    // drops the translated labels, they are rebuilt for the current language on the next use
+    static void retranslate();
 
-protected:
     auto getTxDescription() const -> const beam::wallet::TxDescription&;
+
+protected:
     auto getReasonString(beam::wallet::TxFailureReason reason) const -> QString;
  
     beam::wallet::TxDescription m_tx;
     QString m_kernelID;
-    beam::wallet::TxType m_type;
+    beam::wallet::TxType m_type = beam::wallet::TxType::Simple;
+
+private:
+    // display strings formatted on the first request, a changed transaction gets a new row
+    struct DisplayCache
+    {
+        boost::optional<QString> timeCreated;
+        boost::optional<QString> amountWithCurrency;
+        boost::optional<QString> amount;
+        boost::optional<QString> addressFrom;
+        boost::optional<QString> addressTo;
+        boost::optional<QString> comment;
+        boost::optional<QString> transactionID;
+        boost::optional<QString> search;
+    };
+    mutable DisplayCache m_displayCache;
 };
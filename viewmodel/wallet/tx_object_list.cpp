@@ -13,72 +13,68 @@
 // limitations under the License.
 
 #include "tx_object_list.h"
+#include "model/app_model.h"
 
 namespace
 {
 
-QString getStatusTextTranslated(const QString& status)
+const size_t kPageSize = 100;
+
+using TypedKey = quint64 (*)(const TxObject&);
+
+// sort roles with numeric keys, the key of a row doesn't depend on the other rows
+TypedKey typedKeyOf(int role)
 {
-    if (status == "pending")
-    {
-        //% "pending"
-        return qtTrId("wallet-txs-status-pending");
-    }
-    else if (status == "waiting for sender")
+    switch (static_cast<TxObjectList::Roles>(role))
     {
-        //% "waiting for sender"
-        return qtTrId("wallet-txs-status-waiting-sender");
-    }
-    else if (status == "waiting for receiver")
-    {
-        //% "waiting for receiver"
-        return qtTrId("wallet-txs-status-waiting-receiver");
-    }
-    else if (status == "in progress")
-    {
-        //% "in progress"
-        return qtTrId("wallet-txs-status-in-progress");
-    }
-    else if (status == "sent to own address")
-    {
-        //% "sent to own address"
-        return qtTrId("wallet-txs-status-own-sent");
-    }
-    else if (status == "sending to own address")
-    {
-        //% "sending to own address"
-        return qtTrId("wallet-txs-status-own-sending");
-    }
-    else if (status == "received")
-    {
-        //% "received"
-        return qtTrId("wallet-txs-status-received");
-    }
-    else if (status == "sent")
-    {
-        //% "sent"
-        return qtTrId("wallet-txs-status-sent");
-    }
-    else if (status == "cancelled")
-    {
-        //% "cancelled"
-        return qtTrId("wallet-txs-status-cancelled");
-    }
-    else if (status == "expired")
-    {
-        //% "expired"
-        return qtTrId("wallet-txs-status-expired");
+        case TxObjectList::Roles::TimeCreatedSort:
+            return [](const TxObject& value) { return static_cast<quint64>(value.timeCreated()); };
+
+        case TxObjectList::Roles::AmountGeneralWithCurrencySort:
+        case TxObjectList::Roles::AmountGeneralSort:
+            return [](const TxObject& value) { return static_cast<quint64>(value.getAmountValue()); };
+
+        default:
+            return nullptr;
     }
-    else if (status == "failed")
+}
+
+using SortText = QString (*)(const TxObject&);
+
+// sort roles with collated text keys, the position of a text depends on all the rows
+SortText sortTextOf(int role)
+{
+    switch (static_cast<TxObjectList::Roles>(role))
     {
-        //% "failed"
-        return qtTrId("wallet-txs-status-failed");
+        case TxObjectList::Roles::AddressFromSort:
+            return [](const TxObject& value) { return value.getAddressFrom(); };
+
+        case TxObjectList::Roles::AddressToSort:
+            return [](const TxObject& value) { return value.getAddressTo(); };
+
+        case TxObjectList::Roles::StatusSort:
+            return [](const TxObject& value) { return value.getStatusTranslated(); };
+
+        default:
+            return nullptr;
     }
+}
 
-    else
+using FilterText = QString (*)(const TxObject&);
+
+// filtered roles which texts are kept by the rows
+FilterText filterTextOf(int role)
+{
+    switch (static_cast<TxObjectList::Roles>(role))
     {
-        //% "unknown"
-        return qtTrId("wallet-txs-status-unknown");
+        case TxObjectList::Roles::Search:
+            return [](const TxObject& value) { return value.getSearchString(); };
+
+        case TxObjectList::Roles::Status:
+            return [](const TxObject& value) { return value.getStatusTranslated(); };
+
+        default:
+            return nullptr;
     }
 }
 
@@ -86,6 +82,7 @@ QString getStatusTextTranslated(const QString& status)
 
 TxObjectList::TxObjectList()
 {
+    connect(&AppModel::getInstance().getSettings(), SIGNAL(localeChanged()), SLOT(onLocaleChanged()));
 }
 
 auto TxObjectList::roleNames() const -> QHash<int, QByteArray>
@@ -129,7 +126,7 @@ auto TxObjectList::roleNames() const -> QHash<int, QByteArray>
 
 auto TxObjectList::data(const QModelIndex &index, int role) const -> QVariant
 {
-    if (!index.isValid() || index.row() < 0 || index.row() >= m_list.size())
+    if (!index.isValid() || index.row() < 0 || index.row() >= rowCount())
     {
        return QVariant();
     }
@@ -138,106 +135,436 @@ auto TxObjectList::data(const QModelIndex &index, int role) const -> QVariant
     switch (static_cast<Roles>(role))
     {
         case Roles::TimeCreated:
-        {
-            QDateTime datetime;
-            datetime.setTime_t(value->timeCreated());
-            return datetime.toString(Qt::SystemLocaleShortDate);
-        }
+            return value.getTimeCreated();
             
         case Roles::TimeCreatedSort:
         {
-            return static_cast<qulonglong>(value->timeCreated());
+            return static_cast<qulonglong>(value.timeCreated());
         }
 
         case Roles::AmountGeneralWithCurrency:
-            return value->getAmountWithCurrency();
+            return value.getAmountWithCurrency();
         case Roles::AmountGeneralWithCurrencySort:
-            return static_cast<qulonglong>(value->getAmountValue());
+            return static_cast<qulonglong>(value.getAmountValue());
         case Roles::AmountGeneral:
-            return value->getAmount();
+            return value.getAmount();
         case Roles::AmountGeneralSort:
-            return static_cast<qulonglong>(value->getAmountValue());
+            return static_cast<qulonglong>(value.getAmountValue());
             
         case Roles::AddressFrom:
         case Roles::AddressFromSort:
-            return value->getAddressFrom();
+            return value.getAddressFrom();
 
         case Roles::AddressTo:
         case Roles::AddressToSort:
-            return value->getAddressTo();
+            return value.getAddressTo();
 
         case Roles::Status:
         case Roles::StatusSort:
-            return getStatusTextTranslated(value->getStatus());
+            return value.getStatusTranslated();
 
         case Roles::Fee:
-            return value->getFee();
+            return value.getFee();
 
         case Roles::Comment:
-            return value->getComment();
+            return value.getComment();
 
         case Roles::TxID:
-            return value->getTransactionID();
+            return value.getTransactionID();
 
         case Roles::KernelID:
-            return value->getKernelID();
+            return value.getKernelID();
 
         case Roles::FailureReason:
-            return value->getFailureReason();
+            return value.getFailureReason();
 
         case Roles::IsCancelAvailable:
-            return value->isCancelAvailable();
+            return value.isCancelAvailable();
 
         case Roles::IsDeleteAvailable:
-            return value->isDeleteAvailable();
+            return value.isDeleteAvailable();
 
         case Roles::IsSelfTransaction:
-            return value->isSelfTx();
+            return value.isSelfTx();
 
         case Roles::IsIncome:
-            return value->isIncome();
+            return value.isIncome();
 
         case Roles::IsInProgress:
-            return value->isInProgress();
+            return value.isInProgress();
 
         case Roles::IsPending:
-            return value->isPending();
+            return value.isPending();
 
         case Roles::IsCompleted:
-            return value->isCompleted();
+            return value.isCompleted();
 
         case Roles::IsCanceled:
-            return value->isCanceled();
+            return value.isCanceled();
 
         case Roles::IsFailed:
-            return value->isFailed();
+            return value.isFailed();
 
         case Roles::IsExpired:
-            return value->isExpired();
+            return value.isExpired();
 
         case Roles::HasPaymentProof:
-            return value->hasPaymentProof();
+            return value.hasPaymentProof();
 
         case Roles::RawTxID:
-            return QVariant::fromValue(value->getTxID());
+            return QVariant::fromValue(value.getTxID());
 
-        case Roles::Search: 
-        {
-            QString r = value->getTransactionID();
-            r.append(" ");
-            r.append(value->getKernelID());
-            r.append(" ");
-            r.append(value->getAddressFrom());
-            r.append(" ");
-            r.append(value->getAddressTo());
-            r.append(" ");
-            r.append(value->getComment());
-            return r;
-        }
+        case Roles::Search:
+            return value.getSearchString();
         case Roles::StateDetails:
-            return value->getStateDetails();
+            return value.getStateDetails();
 
         default:
             return QVariant();
     }
 }
+
+auto TxObjectList::sortKeys(int role, Qt::CaseSensitivity cs, std::vector<quint64>& keys) const -> bool
+{
+    if (auto key = typedKeyOf(role))
+    {
+        keys = keysOf(key);
+        return true;
+    }
+    if (auto text = sortTextOf(role))
+    {
+        keys = collatedKeysOf(text, cs);
+        return true;
+    }
+    return false;
+}
+
+auto TxObjectList::updateSortKeys(int role, int first, int last, std::vector<quint64>& keys) const -> bool
+{
+    // collated texts get their positions among all the rows, they are built again
+    if (auto key = typedKeyOf(role))
+    {
+        updateKeysOf(key, first, last, keys);
+        return true;
+    }
+    return false;
+}
+
+auto TxObjectList::sortTexts(int role, std::vector<QString>& texts) const -> bool
+{
+    if (auto text = sortTextOf(role))
+    {
+        texts = textsOf(text);
+        return true;
+    }
+    return false;
+}
+
+auto TxObjectList::filterTexts(int role, const std::vector<int>& rows, std::vector<QString>& texts) const -> bool
+{
+    if (auto text = filterTextOf(role))
+    {
+        texts = textsOf(text, rows);
+        return true;
+    }
+    return false;
+}
+
+auto TxObjectList::changedRoles(const TxObject& before, const TxObject& after, QVector<int>& roles) const -> bool
+{
+    // the fields the roles are made of are compared, nothing is formatted
+    const auto& oldTx = before.getTxDescription();
+    const auto& newTx = after.getTxDescription();
+    auto add = [&roles](std::initializer_list<Roles> changed)
+    {
+        for (auto role : changed)
+        {
+            roles.push_back(static_cast<int>(role));
+        }
+    };
+
+    if (oldTx.m_createTime != newTx.m_createTime)
+    {
+        add({ Roles::TimeCreated, Roles::TimeCreatedSort });
+    }
+    if (oldTx.m_amount != newTx.m_amount)
+    {
+        add({ Roles::AmountGeneralWithCurrency, Roles::AmountGeneralWithCurrencySort, Roles::AmountGeneral, Roles::AmountGeneralSort });
+    }
+    if (oldTx.m_fee != newTx.m_fee)
+    {
+        add({ Roles::Fee });
+    }
+
+    const bool addressesChanged = oldTx.m_sender != newTx.m_sender || oldTx.m_myId != newTx.m_myId || oldTx.m_peerId != newTx.m_peerId;
+    if (addressesChanged)
+    {
+        add({ Roles::AddressFrom, Roles::AddressFromSort, Roles::AddressTo, Roles::AddressToSort, Roles::IsIncome });
+    }
+    if (oldTx.m_status != newTx.m_status || oldTx.m_failureReason != newTx.m_failureReason
+        || oldTx.m_selfTx != newTx.m_selfTx || oldTx.m_sender != newTx.m_sender)
+    {
+        add({ Roles::Status, Roles::StatusSort, Roles::FailureReason, Roles::IsCancelAvailable, Roles::IsDeleteAvailable,
+              Roles::IsSelfTransaction, Roles::IsInProgress, Roles::IsPending, Roles::IsCompleted, Roles::IsCanceled,
+              Roles::IsFailed, Roles::IsExpired, Roles::HasPaymentProof });
+    }
+
+    const bool commentChanged = oldTx.m_message != newTx.m_message;
+    if (commentChanged)
+    {
+        add({ Roles::Comment });
+    }
+    const bool kernelChanged = before.getKernelID() != after.getKernelID();
+    if (kernelChanged)
+    {
+        add({ Roles::KernelID });
+    }
+    if (addressesChanged || commentChanged || kernelChanged)
+    {
+        add({ Roles::Search });
+    }
+
+    if (before.getStateDetails() != after.getStateDetails())
+    {
+        add({ Roles::StateDetails });
+    }
+    return true;
+}
+
+bool TxObjectList::canFetchMore(const QModelIndex &parent) const
+{
+    return !parent.isValid() && !m_pending.empty();
+}
+
+void TxObjectList::fetchMore(const QModelIndex &parent)
+{
+    if (parent.isValid())
+    {
+        return;
+    }
+
+    // only the rows of the page are built and formatted
+    std::vector<TxObject> page;
+    page.reserve(std::min(kPageSize, m_pending.size()));
+    while (!m_pending.empty() && page.size() < kPageSize)
+    {
+        auto it = std::prev(m_pending.end());
+        page.emplace_back(it->second);
+        page.back().prepareDisplay();
+        m_watermark = it->first;
+        m_pendingTimes.erase(it->first.second);
+        m_pending.erase(it);
+    }
+    ListModel::insert(std::move(page));
+}
+
+bool TxObjectList::isPaged() const
+{
+    return m_paged;
+}
+
+void TxObjectList::setPaged(bool value)
+{
+    if (m_paged == value)
+    {
+        return;
+    }
+    // the rows which are already in the model stay there
+    m_paged = value;
+    if (!m_paged)
+    {
+        fetchAll();
+    }
+}
+
+bool TxObjectList::Window::contains(const beam::wallet::TxDescription& tx) const
+{
+    return !m_paged || (m_watermark && !(keyOf(tx) < *m_watermark));
+}
+
+auto TxObjectList::getWindow() const -> Window
+{
+    Window window;
+    window.m_paged = m_paged;
+    window.m_watermark = m_watermark;
+    window.m_localeVersion = m_localeVersion;
+    return window;
+}
+
+auto TxObjectList::makeBatch(const Window& window, const std::vector<beam::wallet::TxDescription>& transactions) -> Batch
+{
+    Batch batch;
+    batch.localeVersion = window.m_localeVersion;
+    for (const auto& tx : transactions)
+    {
+        if (window.contains(tx))
+        {
+            batch.rows.emplace_back(tx);
+            batch.rows.back().prepareDisplay();
+        }
+        else
+        {
+            batch.transactions.push_back(tx);
+        }
+    }
+    return batch;
+}
+
+void TxObjectList::reset(Batch batch)
+{
+    m_pending.clear();
+    m_pendingTimes.clear();
+
+    std::vector<TxObject> rows;
+    split(std::move(batch), rows);
+    ListModel::reset(std::move(rows));
+    fetchFirstPage();
+}
+
+void TxObjectList::insert(Batch batch)
+{
+    std::vector<TxObject> rows;
+    split(std::move(batch), rows);
+    ListModel::insert(std::move(rows));
+    fetchFirstPage();
+}
+
+void TxObjectList::remove(const std::vector<beam::wallet::TxDescription>& items)
+{
+    std::vector<Key> keys;
+    keys.reserve(items.size());
+    for (const auto& item : items)
+    {
+        if (!removePending(item.m_txId))
+        {
+            keys.push_back(item.m_txId);
+        }
+    }
+    ListModel::removeKeys(keys);
+}
+
+void TxObjectList::update(Batch batch)
+{
+    std::vector<TxObject> rows;
+    split(std::move(batch), rows);
+    ListModel::update(std::move(rows));
+    fetchFirstPage();
+}
+
+auto TxObjectList::keyOf(const beam::wallet::TxDescription& tx) -> PendingKey
+{
+    return PendingKey(tx.m_createTime, tx.m_txId);
+}
+
+bool TxObjectList::isMaterialized(const PendingKey& key) const
+{
+    return !m_paged || (m_watermark && !(key < *m_watermark));
+}
+
+void TxObjectList::addPending(beam::wallet::TxDescription&& tx)
+{
+    const auto key = keyOf(tx);
+    m_pending[key] = std::move(tx);
+    m_pendingTimes[key.second] = key.first;
+}
+
+bool TxObjectList::removePending(const beam::wallet::TxID& txID)
+{
+    auto it = m_pendingTimes.find(txID);
+    if (it == m_pendingTimes.end())
+    {
+        return false;
+    }
+    m_pending.erase(PendingKey(it->second, txID));
+    m_pendingTimes.erase(it);
+    return true;
+}
+
+void TxObjectList::split(Batch&& batch, std::vector<TxObject>& rows)
+{
+    rows.reserve(batch.rows.size() + batch.transactions.size());
+    // the window may have moved since the batch was made
+    for (auto& row : batch.rows)
+    {
+        if (batch.localeVersion != m_localeVersion)
+        {
+            row.resetDisplayCache();
+        }
+        const auto key = keyOf(row.getTxDescription());
+        if (isMaterialized(key))
+        {
+            lowerWatermark(key);
+            rows.push_back(std::move(row));
+        }
+        else
+        {
+            addPending(beam::wallet::TxDescription(row.getTxDescription()));
+        }
+    }
+    for (auto& tx : batch.transactions)
+    {
+        const auto key = keyOf(tx);
+        if (isMaterialized(key))
+        {
+            lowerWatermark(key);
+            rows.emplace_back(tx);
+        }
+        else
+        {
+            addPending(std::move(tx));
+        }
+    }
+}
+
+void TxObjectList::fetchFirstPage()
+{
+    // views ask for the next pages themselves, but an empty model has to show something first
+    if (m_list.empty() && canFetchMore(QModelIndex()))
+    {
+        fetchMore(QModelIndex());
+    }
+}
+
+void TxObjectList::fetchAll()
+{
+    // the strings are formatted when the proxies or the views read them
+    std::vector<TxObject> rows;
+    rows.reserve(m_pending.size());
+    for (auto it = m_pending.rbegin(); it != m_pending.rend(); ++it)
+    {
+        rows.emplace_back(it->second);
+    }
+    if (!m_pending.empty())
+    {
+        lowerWatermark(m_pending.begin()->first);
+    }
+    m_pending.clear();
+    m_pendingTimes.clear();
+    ListModel::insert(std::move(rows));
+}
+
+void TxObjectList::lowerWatermark(const PendingKey& key)
+{
+    // an older row which comes while the list is not paged keeps the materialized range contiguous
+    if (!m_watermark || key < *m_watermark)
+    {
+        m_watermark = key;
+    }
+}
+
+void TxObjectList::onLocaleChanged()
+{
+    // formatted values depend on the locale, views have to re-read all the rows;
+    // pending transactions are not formatted yet and the rows of the batches
+    // which are on the way drop their strings when they come
+    ++m_localeVersion;
+    TxObject::retranslate();
+    for (auto& value : m_list)
+    {
+        value.resetDisplayCache();
+    }
+    if (!m_list.empty())
+    {
+        emit dataChanged(index(0), index(rowCount() - 1));
+    }
+}
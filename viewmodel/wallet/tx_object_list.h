@@ -14,14 +14,17 @@
 
 #pragma once
 
+#include <map>
 #include "tx_object.h"
 #include "viewmodel/helpers/list_model.h"
 
-class TxObjectList : public ListModel<std::shared_ptr<TxObject>>
+class TxObjectList : public ListModel<TxObject>
 {
 
     Q_OBJECT
 
+    using PendingKey = std::pair<beam::Timestamp, beam::wallet::TxID>;
+
 public:
     enum class Roles
     {
@@ -58,8 +61,75 @@ public:
         StateDetails
     };
 
+    // the transactions which are shown at the time it is taken, a copy can be used on any thread
+    class Window
+    {
+    public:
+        bool contains(const beam::wallet::TxDescription& tx) const;
+
+    private:
+        friend class TxObjectList;
+        bool m_paged = true;
+        boost::optional<PendingKey> m_watermark;
+        quint64 m_localeVersion = 0;
+    };
+
+    // transactions of one change, the ones in the window come as rows ready for display
+    struct Batch
+    {
+        std::vector<TxObject> rows;
+        std::vector<beam::wallet::TxDescription> transactions;
+        // the rows were formatted for this locale
+        quint64 localeVersion = 0;
+    };
+
     TxObjectList();
 
     QVariant data(const QModelIndex &index, int role) const override;
     QHash<int, QByteArray> roleNames() const override;
+    bool sortKeys(int role, Qt::CaseSensitivity cs, std::vector<quint64>& keys) const override;
+    bool updateSortKeys(int role, int first, int last, std::vector<quint64>& keys) const override;
+    bool sortTexts(int role, std::vector<QString>& texts) const override;
+    bool filterTexts(int role, const std::vector<int>& rows, std::vector<QString>& texts) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
+
+    // while paged the older rows are materialized on demand, otherwise all of them
+    // are in the model, so the proxies can search and sort the whole history
+    bool isPaged() const;
+    void setPaged(bool value);
+
+    Window getWindow() const;
+    // any thread, only the transactions in the window are built, the others are kept raw
+    static Batch makeBatch(const Window& window, const std::vector<beam::wallet::TxDescription>& transactions);
+
+    // rows are shown on demand, newest first, the rest is kept aside as it came from the wallet
+    void reset(Batch batch);
+    void insert(Batch batch);
+    void remove(const std::vector<beam::wallet::TxDescription>& items);
+    void update(Batch batch);
+
+protected:
+    bool changedRoles(const TxObject& before, const TxObject& after, QVector<int>& roles) const override;
+
+private slots:
+    void onLocaleChanged();
+
+private:
+    static PendingKey keyOf(const beam::wallet::TxDescription& tx);
+    bool isMaterialized(const PendingKey& key) const;
+    void addPending(beam::wallet::TxDescription&& tx);
+    bool removePending(const beam::wallet::TxID& txID);
+    void split(Batch&& batch, std::vector<TxObject>& rows);
+    void fetchFirstPage();
+    void fetchAll();
+    void lowerWatermark(const PendingKey& key);
+
+    std::map<PendingKey, beam::wallet::TxDescription> m_pending;
+    std::unordered_map<beam::wallet::TxID, beam::Timestamp, ListModelKeyHash<beam::wallet::TxID>> m_pendingTimes;
+    bool m_paged = true;
+    // rows with keys starting from this one are materialized
+    boost::optional<PendingKey> m_watermark;
+    // bumped on every change of the locale
+    quint64 m_localeVersion = 0;
 };
@@ -44,9 +44,11 @@ const char kTxHistoryFileNameFormat[] = "yyyy_MM_dd_HH_mm_ss";
 WalletViewModel::WalletViewModel()
     : _model(*AppModel::getInstance().getWallet())
     , _settings(AppModel::getInstance().getSettings())
+    , _rowPipeline(this)
 {
-    connect(&_model, SIGNAL(transactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)),
-        SLOT(onTransactionsChanged(beam::wallet::ChangeAction, const std::vector<beam::wallet::TxDescription>&)));
+    auto& transactionStore = AppModel::getInstance().getTransactionStore();
+    connect(&transactionStore, SIGNAL(simpleTransactionsChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>&)),
+        SLOT(onTransactionsChanged(beam::wallet::ChangeAction, const SharedItems<beam::wallet::TxDescription>&)));
 
     connect(&_model, SIGNAL(availableChanged()), this, SIGNAL(beamAvailableChanged()));
     connect(&_model, SIGNAL(receivingChanged()), this, SIGNAL(beamReceivingChanged()));
@@ -57,7 +59,10 @@ WalletViewModel::WalletViewModel()
     connect(&_model, SIGNAL(txHistoryExportedToCsv(const QString&)),
             this, SLOT(onTxHistoryExportedToCsv(const QString&)));
 
-    _model.getAsync()->getTransactions();
+    if (transactionStore.isLoaded())
+    {
+        onTransactionsChanged(ChangeAction::Reset, transactionStore.getTransactions(TransactionStore::Kind::Simple));
+    }
 }
 
 QAbstractItemModel* WalletViewModel::getTransactions()
@@ -65,6 +70,20 @@ QAbstractItemModel* WalletViewModel::getTransactions()
     return &_transactionsList;
 }
 
+bool WalletViewModel::isTransactionsPaged() const
+{
+    return _transactionsList.isPaged();
+}
+
+void WalletViewModel::setTransactionsPaged(bool value)
+{
+    if (value != _transactionsList.isPaged())
+    {
+        _transactionsList.setPaged(value);
+        emit transactionsPagedChanged();
+    }
+}
+
 void WalletViewModel::cancelTx(const QVariant& variantTxID)
 {
     if (!variantTxID.isNull() && variantTxID.isValid())
@@ -93,51 +112,51 @@ PaymentInfoItem* WalletViewModel::getPaymentInfo(const QVariant& variantTxID)
     else return Q_NULLPTR;
 }
 
-void WalletViewModel::onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& transactions)
+void WalletViewModel::onTransactionsChanged(beam::wallet::ChangeAction action, const SharedItems<beam::wallet::TxDescription>& transactions)
 {
-    vector<shared_ptr<TxObject>> modifiedTransactions;
-    modifiedTransactions.reserve(transactions.size());
-
-    for (const auto& t : transactions)
+    // rows of the shown transactions are built on the thread pool, the others are kept raw
+    // until their page is needed, the list only takes them over
+    _rowPipeline.post([action, transactions, window = _transactionsList.getWindow()]()
     {
-        if (t.GetParameter<TxType>(TxParameterID::TransactionType) != TxType::AtomicSwap)
+        if (action == ChangeAction::Removed)
         {
-            modifiedTransactions.push_back(make_shared<TxObject>(t));
+            return TxObjectList::Batch();
         }
-    }
-
-    switch (action)
+        return TxObjectList::makeBatch(window, *transactions);
+    },
+    [this, action, transactions](TxObjectList::Batch& batch)
     {
-        case ChangeAction::Reset:
-            {
-                _transactionsList.reset(modifiedTransactions);
-                break;
-            }
-
-        case ChangeAction::Removed:
-            {
-                _transactionsList.remove(modifiedTransactions);
-                break;
-            }
-
-        case ChangeAction::Added:
-            {
-                _transactionsList.insert(modifiedTransactions);
-                break;
-            }
-        
-        case ChangeAction::Updated:
-            {
-                _transactionsList.update(modifiedTransactions);
+        switch (action)
+        {
+            case ChangeAction::Reset:
+                {
+                    _transactionsList.reset(std::move(batch));
+                    break;
+                }
+
+            case ChangeAction::Removed:
+                {
+                    _transactionsList.remove(*transactions);
+                    break;
+                }
+
+            case ChangeAction::Added:
+                {
+                    _transactionsList.insert(std::move(batch));
+                    break;
+                }
+
+            case ChangeAction::Updated:
+                {
+                    _transactionsList.update(std::move(batch));
+                    break;
+                }
+
+            default:
+                assert(false && "Unexpected action");
                 break;
-            }
-
-        default:
-            assert(false && "Unexpected action");
-            break;
-    }
-
-    emit transactionsChanged();
+        }
+    });
 }
 
 void WalletViewModel::onTxHistoryExportedToCsv(const QString& data)
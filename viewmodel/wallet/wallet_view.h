@@ -22,6 +22,7 @@
 #include "model/settings.h"
 #include "viewmodel/messages_view.h"
 #include "tx_object_list.h"
+#include "viewmodel/helpers/row_pipeline.h"
 
 class WalletViewModel : public QObject
 {
@@ -35,6 +36,8 @@ class WalletViewModel : public QObject
     Q_PROPERTY(QString beamReceivingIncoming         READ beamReceivingIncoming      NOTIFY beamReceivingChanged)
     Q_PROPERTY(bool isAllowedBeamMWLinks             READ isAllowedBeamMWLinks       WRITE allowBeamMWLinks      NOTIFY beamMWLinksAllowed)
     Q_PROPERTY(QAbstractItemModel* transactions      READ getTransactions            NOTIFY transactionsChanged)
+    // older transactions are loaded page by page, a view which filters or sorts them turns it off
+    Q_PROPERTY(bool transactionsPaged                READ isTransactionsPaged        WRITE setTransactionsPaged  NOTIFY transactionsPagedChanged)
 
 public:
     WalletViewModel();
@@ -48,6 +51,8 @@ public:
     QString  beamReceivingIncoming() const;
 
     QAbstractItemModel* getTransactions();
+    bool isTransactionsPaged() const;
+    void setTransactionsPaged(bool value);
     bool getIsOfflineStatus() const;
     bool getIsFailedStatus() const;
     QString getWalletStatusErrorMsg() const;
@@ -60,7 +65,7 @@ public:
     Q_INVOKABLE void exportTxHistoryToCsv();
 
 public slots:
-    void onTransactionsChanged(beam::wallet::ChangeAction action, const std::vector<beam::wallet::TxDescription>& items);
+    void onTransactionsChanged(beam::wallet::ChangeAction action, const SharedItems<beam::wallet::TxDescription>& items);
     void onTxHistoryExportedToCsv(const QString& data);
 
 signals:
@@ -70,11 +75,13 @@ signals:
     void beamLockedChanged();
 
     void transactionsChanged();
+    void transactionsPagedChanged();
     void beamMWLinksAllowed();
 
 private:
     WalletModel& _model;
     WalletSettings& _settings;
     TxObjectList _transactionsList;
+    RowPipeline<TxObjectList::Batch> _rowPipeline;
     QQueue<QString> _txHistoryToCsvPaths;
 };